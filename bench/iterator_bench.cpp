@@ -0,0 +1,57 @@
+#include "./lib/DynamicBuffer/DynamicBuffer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+
+template<typename F>
+double measure(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Checking>
+void run(const char *name, size_t n, int rounds) {
+    DynamicBuffer<int, std::allocator<int>, Checking> buf(n);
+    std::mt19937 gen(42);
+    for (size_t i = 0; i < n; i++) {
+        buf.push_back(static_cast<int>(gen()));
+    }
+    for (size_t i = 0; i < n / 2; i++) {
+        buf.pop_front();
+        buf.push_back(static_cast<int>(gen()));
+    }
+
+    long long sum = 0;
+    double range_for = measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (auto x: buf) sum += x;
+        }
+    });
+    double index = measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (size_t i = 0; i < buf.size(); i++) sum += buf[i];
+        }
+    });
+    double accumulate = measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            sum += std::accumulate(buf.begin(), buf.end(), 0LL);
+        }
+    });
+    double sort = measure([&] {
+        std::sort(buf.begin(), buf.end());
+    });
+
+    std::cout << name << ": range-for " << range_for << " ms, operator[] " << index << " ms, accumulate "
+              << accumulate << " ms, sort " << sort << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1 << 20;
+    int rounds = argc > 2 ? std::stoi(argv[2]) : 20;
+    std::cout << "elements: " << n << ", rounds: " << rounds << "\n";
+    run<unchecked_policy>("unchecked", n, rounds);
+    run<checked_policy>("checked  ", n, rounds);
+    run<hardened_policy>("hardened ", n, rounds);
+}
@@ -0,0 +1,135 @@
+#include "./lib/WorkStealingDeque/WorkStealingDeque.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+// Minimal work-stealing pool: every worker owns a WorkStealingDeque of tasks, pops its own
+// work first and steals from random victims when idle. Threads outside the pool submit
+// through a locked injection queue.
+class WorkStealingPool {
+private:
+    using Task = std::function<void()>;
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Task *>>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stop_{false};
+    std::mutex inject_mutex_;
+    std::deque<Task *> inject_;
+
+    static thread_local WorkStealingPool *pool_;
+    static thread_local size_t index_;
+
+    Task *find_task() {
+        if (pool_ == this) {
+            if (auto task = queues_[index_]->pop()) return *task;
+        }
+        thread_local std::minstd_rand gen(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            if (auto task = queues_[gen() % queues_.size()]->steal()) return *task;
+        }
+        std::lock_guard lock(inject_mutex_);
+        if (inject_.empty()) return nullptr;
+        Task *task = inject_.front();
+        inject_.pop_front();
+        return task;
+    }
+
+public:
+    explicit WorkStealingPool(size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            queues_.push_back(std::make_unique<WorkStealingDeque<Task *>>());
+        }
+        for (size_t i = 0; i < n; ++i) {
+            threads_.emplace_back([this, i] {
+                pool_ = this;
+                index_ = i;
+                while (!stop_.load(std::memory_order_relaxed)) {
+                    if (!run_one()) std::this_thread::yield();
+                }
+            });
+        }
+    }
+
+    ~WorkStealingPool() {
+        stop_ = true;
+        for (auto &t: threads_) {
+            t.join();
+        }
+    }
+
+    void spawn(Task fn) {
+        auto *task = new Task(std::move(fn));
+        if (pool_ == this) {
+            queues_[index_]->push(task);
+            return;
+        }
+        std::lock_guard lock(inject_mutex_);
+        inject_.push_back(task);
+    }
+
+    bool run_one() {
+        Task *task = find_task();
+        if (task == nullptr) return false;
+        (*task)();
+        delete task;
+        return true;
+    }
+
+    // Runs other tasks until the flag is set, so waiting workers keep the pool busy.
+    void wait(const std::atomic<bool> &flag) {
+        while (!flag.load(std::memory_order_acquire)) {
+            if (!run_one()) std::this_thread::yield();
+        }
+    }
+};
+
+thread_local WorkStealingPool *WorkStealingPool::pool_ = nullptr;
+thread_local size_t WorkStealingPool::index_ = 0;
+
+long serial_fib(int n) {
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+long parallel_fib(WorkStealingPool &pool, int n) {
+    if (n < 20) return serial_fib(n);
+    long a = 0;
+    std::atomic<bool> done{false};
+    pool.spawn([&] {
+        a = parallel_fib(pool, n - 1);
+        done.store(true, std::memory_order_release);
+    });
+    long b = parallel_fib(pool, n - 2);
+    pool.wait(done);
+    return a + b;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? std::stoi(argv[1]) : 34;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::steady_clock::now();
+    long expected = serial_fib(n);
+    double serial = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "fib(" << n << ") = " << expected << ", serial " << serial << " ms\n";
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        WorkStealingPool pool(threads);
+        long result = 0;
+        std::atomic<bool> done{false};
+        start = std::chrono::steady_clock::now();
+        pool.spawn([&] {
+            result = parallel_fib(pool, n);
+            done.store(true, std::memory_order_release);
+        });
+        while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << threads << " threads: " << ms << " ms, speedup " << serial / ms
+                  << (result == expected ? "" : " (wrong result)") << "\n";
+    }
+}
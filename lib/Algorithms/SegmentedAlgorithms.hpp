@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../CycleBuffer/CycleBuffer.hpp"
+#include <execution>
+#include <functional>
+#include <numeric>
+
+// Algorithms over the contiguous segments of a buffer: the work is split at the wrap point,
+// so every call below runs on plain pointers and may use an execution policy.
+namespace segmented {
+
+    template<typename Policy>
+    concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<Policy>>;
+
+    template<typename T, typename Alloc, typename Checking, typename F>
+    F for_each(CycleBuffer<T, Alloc, Checking> &buf, F f) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            f = std::for_each(seg.data(), seg.data() + seg.size(), f);
+        }
+        return f;
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking, typename F>
+    void for_each(Policy &&policy, CycleBuffer<T, Alloc, Checking> &buf, F f) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            std::for_each(policy, seg.data(), seg.data() + seg.size(), f);
+        }
+    }
+
+    template<typename T, typename Alloc, typename Checking, typename OutputIt, typename UnaryOp>
+    OutputIt transform(const CycleBuffer<T, Alloc, Checking> &buf, OutputIt out, UnaryOp op) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            out = std::transform(seg.data(), seg.data() + seg.size(), out, op);
+        }
+        return out;
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking, typename ForwardIt, typename UnaryOp>
+    ForwardIt transform(Policy &&policy, const CycleBuffer<T, Alloc, Checking> &buf, ForwardIt out, UnaryOp op) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            out = std::transform(policy, seg.data(), seg.data() + seg.size(), out, op);
+        }
+        return out;
+    }
+
+    template<typename T, typename Alloc, typename Checking, typename OutputIt>
+    OutputIt copy(const CycleBuffer<T, Alloc, Checking> &buf, OutputIt out) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            out = std::copy(seg.data(), seg.data() + seg.size(), out);
+        }
+        return out;
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking, typename ForwardIt>
+    ForwardIt copy(Policy &&policy, const CycleBuffer<T, Alloc, Checking> &buf, ForwardIt out) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            out = std::copy(policy, seg.data(), seg.data() + seg.size(), out);
+        }
+        return out;
+    }
+
+    template<typename T, typename Alloc, typename Checking>
+    void fill(CycleBuffer<T, Alloc, Checking> &buf, const T &value) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            std::fill(seg.data(), seg.data() + seg.size(), value);
+        }
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking>
+    void fill(Policy &&policy, CycleBuffer<T, Alloc, Checking> &buf, const T &value) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            std::fill(policy, seg.data(), seg.data() + seg.size(), value);
+        }
+    }
+
+    template<typename T, typename Alloc, typename Checking, typename Init = T, typename BinaryOp = std::plus<>>
+    Init reduce(const CycleBuffer<T, Alloc, Checking> &buf, Init init = Init(), BinaryOp op = BinaryOp()) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            init = std::reduce(seg.data(), seg.data() + seg.size(), init, op);
+        }
+        return init;
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking, typename Init = T, typename BinaryOp = std::plus<>>
+    Init reduce(Policy &&policy, const CycleBuffer<T, Alloc, Checking> &buf, Init init = Init(), BinaryOp op = BinaryOp()) {
+        for (auto seg: {buf.first_segment(), buf.second_segment()}) {
+            init = std::reduce(policy, seg.data(), seg.data() + seg.size(), init, op);
+        }
+        return init;
+    }
+
+    // Sorting needs a single range, so the buffer is linearized first.
+    template<typename T, typename Alloc, typename Checking, typename Compare = std::less<>>
+    void sort(CycleBuffer<T, Alloc, Checking> &buf, Compare comp = Compare()) {
+        T *first = buf.linearize();
+        std::sort(first, first + buf.size(), comp);
+    }
+
+    template<execution_policy Policy, typename T, typename Alloc, typename Checking, typename Compare = std::less<>>
+    void sort(Policy &&policy, CycleBuffer<T, Alloc, Checking> &buf, Compare comp = Compare()) {
+        T *first = buf.linearize();
+        std::sort(policy, first, first + buf.size(), comp);
+    }
+
+}
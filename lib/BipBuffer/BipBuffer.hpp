@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../CycleBuffer/CycleBuffer.hpp"
+
+// Reserve/commit buffer over CycleBuffer storage. Data lives in at most two regions, A and
+// a region B that starts at the beginning of the storage once A reaches the end, so every
+// write grant and every read grant is contiguous and never straddles the wrap point.
+template<typename T, typename Alloc = std::allocator<T>>
+class BipBuffer : private CycleBuffer<T, Alloc> {
+    static_assert(std::is_trivially_copyable_v<T>, "BipBuffer requires a trivially copyable type");
+
+private:
+    using CycleBuffer<T, Alloc>::objects_;
+
+    size_t a_start_ = 0;
+    size_t a_end_ = 0;
+    size_t b_end_ = 0;
+    bool b_active_ = false;
+    size_t grant_start_ = 0;
+    size_t grant_size_ = 0;
+
+public:
+    explicit BipBuffer(size_t c) : CycleBuffer<T, Alloc>(c) {}
+
+    BipBuffer(const BipBuffer &other) = delete;
+
+    BipBuffer &operator=(const BipBuffer &other) = delete;
+
+    // Grants up to n writable elements, picking the larger free region when the one after A
+    // is too small. The grant may be shorter than n, or empty when the buffer is full.
+    std::span<T> reserve_write(size_t n) {
+        size_t start;
+        size_t free;
+        if (b_active_) {
+            start = b_end_;
+            free = a_start_ - b_end_;
+        } else if (a_start_ == a_end_) {
+            a_start_ = a_end_ = 0;
+            start = 0;
+            free = capacity();
+        } else if (capacity() - a_end_ >= n || capacity() - a_end_ >= a_start_) {
+            start = a_end_;
+            free = capacity() - a_end_;
+        } else {
+            start = 0;
+            free = a_start_;
+        }
+        grant_start_ = start;
+        grant_size_ = std::min(n, free);
+        return {objects_ + start, grant_size_};
+    }
+
+    // Publishes the first k elements of the last grant.
+    void commit(size_t k) {
+        if (k > grant_size_) throw std::out_of_range("commit exceeds the write grant");
+        if (k != 0) {
+            // The reader may have drained A since the grant was made; an empty A then
+            // simply moves to the grant, so B is never active while A is empty.
+            if (!b_active_ && a_start_ == a_end_) {
+                a_start_ = grant_start_;
+                a_end_ = grant_start_ + k;
+            } else if (!b_active_ && grant_start_ == a_end_) {
+                a_end_ += k;
+            } else {
+                b_active_ = true;
+                b_end_ = grant_start_ + k;
+            }
+        }
+        grant_size_ = 0;
+    }
+
+    [[nodiscard]] std::span<const T> read_grant() const {
+        return {objects_ + a_start_, a_end_ - a_start_};
+    }
+
+    void release(size_t k) {
+        if (k > a_end_ - a_start_) throw std::out_of_range("release exceeds the read grant");
+        a_start_ += k;
+        if (a_start_ == a_end_) {
+            a_start_ = 0;
+            a_end_ = b_active_ ? b_end_ : 0;
+            b_end_ = 0;
+            b_active_ = false;
+        }
+    }
+
+    [[nodiscard]] size_t size() const {
+        return a_end_ - a_start_ + (b_active_ ? b_end_ : 0);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+
+    using CycleBuffer<T, Alloc>::capacity;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../CycleBuffer/CycleBuffer.hpp"
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Byte ring for socket I/O: read_from/write_to move data between a descriptor and the
+// buffer's two segments with a single readv/writev, without intermediate copies.
+// Both return the result of the system call, like read(2)/write(2).
+template<typename Alloc = std::allocator<char>>
+class ByteBuffer : public CycleBuffer<char, Alloc> {
+private:
+    using CycleBuffer<char, Alloc>::capacity_;
+    using CycleBuffer<char, Alloc>::objects_;
+    using CycleBuffer<char, Alloc>::begin_;
+    using CycleBuffer<char, Alloc>::end_;
+
+    // The slot just before begin_ stays free to tell a full buffer from an empty one.
+    int free_segments(iovec *iov) {
+        char *limit = begin_ == objects_ ? objects_ + capacity_ - 1 : begin_ - 1;
+        if (end_ <= limit) {
+            iov[0] = {end_, static_cast<size_t>(limit - end_)};
+            return 1;
+        }
+        iov[0] = {end_, static_cast<size_t>(objects_ + capacity_ - end_)};
+        iov[1] = {objects_, static_cast<size_t>(limit - objects_)};
+        return 2;
+    }
+
+    void advance_end(size_t n) {
+        end_ = objects_ + (end_ - objects_ + n) % capacity_;
+    }
+
+    void ensure_free(size_t n) {
+        if (free_space() < n) this->reserve(std::max(this->size() + n, this->capacity() * 2));
+    }
+
+public:
+    ByteBuffer() : CycleBuffer<char, Alloc>() {};
+
+    explicit ByteBuffer(size_t c) : CycleBuffer<char, Alloc>(c) {};
+
+    [[nodiscard]] size_t free_space() const {
+        return this->capacity() - this->size();
+    }
+
+    void append(const char *data, size_t n) {
+        ensure_free(n);
+        iovec iov[2];
+        int count = free_segments(iov);
+        size_t first = std::min(n, iov[0].iov_len);
+        std::memcpy(iov[0].iov_base, data, first);
+        if (count == 2 && n > first) std::memcpy(iov[1].iov_base, data + first, n - first);
+        advance_end(n);
+    }
+
+    // Contiguous readable bytes at the front; linearize() makes this cover the whole buffer.
+    [[nodiscard]] std::span<const char> peek() const {
+        return this->first_segment();
+    }
+
+    size_t peek(char *out, size_t n) const {
+        auto first = this->first_segment();
+        auto second = this->second_segment();
+        size_t a = std::min(n, first.size());
+        size_t b = std::min(n - a, second.size());
+        std::memcpy(out, first.data(), a);
+        if (b != 0) std::memcpy(out + a, second.data(), b);
+        return a + b;
+    }
+
+    void consume(size_t n) {
+        n = std::min(n, this->size());
+        begin_ = objects_ + (begin_ - objects_ + n) % capacity_;
+        if (begin_ == end_) begin_ = end_ = objects_;
+    }
+
+    void clear() {
+        begin_ = end_ = objects_;
+    }
+
+    // Reads up to max bytes, growing geometrically like append if less than max is free.
+    // max must be positive, so a return of 0 always means end of file.
+    ssize_t read_from(int fd, size_t max) {
+        if (max == 0) throw std::out_of_range("read size must be positive");
+        ensure_free(max);
+        iovec iov[2];
+        int count = free_segments(iov);
+        if (iov[0].iov_len >= max) {
+            iov[0].iov_len = max;
+            count = 1;
+        } else if (count == 2) {
+            iov[1].iov_len = std::min(iov[1].iov_len, max - iov[0].iov_len);
+        }
+        ssize_t n = readv(fd, iov, count);
+        if (n > 0) advance_end(n);
+        return n;
+    }
+
+    ssize_t write_to(int fd) {
+        auto first = this->first_segment();
+        auto second = this->second_segment();
+        iovec iov[2] = {{first.data(), first.size()}, {second.data(), second.size()}};
+        ssize_t n = writev(fd, iov, second.empty() ? 1 : 2);
+        if (n > 0) consume(n);
+        return n;
+    }
+};
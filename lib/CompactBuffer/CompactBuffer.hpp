@@ -0,0 +1,333 @@
+#pragma once
+
+#include "../IndexIterator/IndexIterator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+// Growable ring with a compact layout: a data pointer plus 32-bit head, size and capacity.
+// Unlike CycleBuffer there is no end sentinel, so all allocated slots hold elements.
+template<typename T, typename Alloc = std::allocator<T>>
+class CompactBuffer {
+private:
+    using allocator_traits = std::allocator_traits<Alloc>;
+
+    T *objects_ = nullptr;
+    uint32_t head_ = 0;
+    uint32_t size_ = 0;
+    uint32_t capacity_ = 0;
+    [[no_unique_address]] Alloc alloc;
+
+    size_t physical(size_t i) const {
+        size_t pos = head_ + i;
+        return pos >= capacity_ ? pos - capacity_ : pos;
+    }
+
+    // Doubles, but never past the 32-bit index limit.
+    void grow() {
+        if (capacity_ == UINT32_MAX) throw std::length_error("CompactBuffer capacity exceeds 32 bits");
+        reserve(capacity_ == 0 ? 1 : std::min<size_t>(size_t(capacity_) * 2, UINT32_MAX));
+    }
+
+public:
+    using value_type = T;
+    using iterator = IndexIterator<CompactBuffer, false>;
+    using const_iterator = IndexIterator<CompactBuffer, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    CompactBuffer() = default;
+
+    explicit CompactBuffer(size_t c) {
+        reserve(c);
+    }
+
+    CompactBuffer(size_t c, const T &element) {
+        resize(c, element);
+    }
+
+    CompactBuffer(const CompactBuffer &other)
+            : alloc(allocator_traits::select_on_container_copy_construction(other.alloc)) {
+        try {
+            reserve(other.capacity_);
+            for (const T &x: other.first_segment()) {
+                push_back(x);
+            }
+            for (const T &x: other.second_segment()) {
+                push_back(x);
+            }
+        }
+        catch (...) {
+            clear();
+            if (objects_ != nullptr) allocator_traits::deallocate(alloc, objects_, capacity_);
+            throw;
+        }
+    }
+
+    CompactBuffer &operator=(const CompactBuffer &other) {
+        if (this == &other) return *this;
+        CompactBuffer temp(other);
+        swap(temp);
+        return *this;
+    }
+
+    ~CompactBuffer() {
+        clear();
+        if (objects_ != nullptr) allocator_traits::deallocate(alloc, objects_, capacity_);
+    }
+
+    void swap(CompactBuffer &other) {
+        std::swap(objects_, other.objects_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(alloc, other.alloc);
+    }
+
+    void reserve(size_t n) {
+        if (n <= capacity_) return;
+        if (n > UINT32_MAX) throw std::length_error("CompactBuffer capacity exceeds 32 bits");
+        T *new_obj = allocator_traits::allocate(alloc, n);
+        size_t moved = 0;
+        try {
+            for (; moved < size_; ++moved) {
+                std::construct_at(new_obj + moved, std::move_if_noexcept(objects_[physical(moved)]));
+            }
+        }
+        catch (...) {
+            std::destroy(new_obj, new_obj + moved);
+            allocator_traits::deallocate(alloc, new_obj, n);
+            throw;
+        }
+        if (objects_ != nullptr) {
+            for (size_t i = 0; i < size_; ++i) {
+                std::destroy_at(objects_ + physical(i));
+            }
+            allocator_traits::deallocate(alloc, objects_, capacity_);
+        }
+        objects_ = new_obj;
+        head_ = 0;
+        capacity_ = static_cast<uint32_t>(n);
+    }
+
+    void resize(size_t n, const T &element = T()) {
+        while (size_ > n) {
+            pop_back();
+        }
+        reserve(n);
+        while (size_ < n) {
+            push_back(element);
+        }
+    }
+
+    void push_back(const T &element) {
+        if (size_ == capacity_) {
+            T value(element);
+            grow();
+            return push_back(value);
+        }
+        std::construct_at(objects_ + physical(size_), element);
+        ++size_;
+    }
+
+    void push_front(const T &element) {
+        if (size_ == capacity_) {
+            T value(element);
+            grow();
+            return push_front(value);
+        }
+        uint32_t pos = head_ == 0 ? capacity_ - 1 : head_ - 1;
+        std::construct_at(objects_ + pos, element);
+        head_ = pos;
+        ++size_;
+    }
+
+    void pop_back() {
+        if (size_ == 0) return;
+        --size_;
+        std::destroy_at(objects_ + physical(size_));
+    }
+
+    void pop_front() {
+        if (size_ == 0) return;
+        std::destroy_at(objects_ + head_);
+        head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+        --size_;
+    }
+
+    void clear() {
+        while (size_ != 0) {
+            pop_back();
+        }
+        head_ = 0;
+    }
+
+    template<std::input_iterator InputIt>
+    void assign(InputIt f, InputIt l) {
+        clear();
+        for (; f != l; ++f) {
+            push_back(*f);
+        }
+    }
+
+    void assign(std::initializer_list<T> l) {
+        assign(l.begin(), l.end());
+    }
+
+    void assign(size_t n, const T &element) {
+        clear();
+        reserve(n);
+        for (; n > 0; --n) {
+            push_back(element);
+        }
+    }
+
+    // Every insert appends at the back and rotates the new elements into place.
+    iterator insert(iterator p, const T &element) {
+        auto index = p - begin();
+        push_back(element);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    iterator insert(iterator p, size_t n, const T &element) {
+        auto index = p - begin();
+        T value(element);
+        reserve(size_t(size_) + n);
+        for (size_t i = 0; i < n; ++i) {
+            push_back(value);
+        }
+        std::rotate(begin() + index, end() - n, end());
+        return begin() + index;
+    }
+
+    template<std::input_iterator InputIt>
+    iterator insert(iterator p, InputIt f, InputIt l) {
+        auto index = p - begin();
+        auto old_size = size_;
+        for (; f != l; ++f) {
+            push_back(*f);
+        }
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+    }
+
+    iterator insert(iterator p, std::initializer_list<T> l) {
+        return insert(p, l.begin(), l.end());
+    }
+
+    iterator erase(iterator q1, iterator q2) {
+        auto index = q1 - begin();
+        auto count = q2 - q1;
+        std::move(q2, end(), q1);
+        for (; count > 0; --count) {
+            pop_back();
+        }
+        return begin() + index;
+    }
+
+    iterator erase(iterator q) {
+        return erase(q, q + 1);
+    }
+
+    bool operator==(const CompactBuffer &other) const {
+        return size_ == other.size_ && std::equal(cbegin(), cend(), other.cbegin());
+    }
+
+    T &operator[](size_t i) {
+        return objects_[physical(i)];
+    }
+
+    const T &operator[](size_t i) const {
+        return objects_[physical(i)];
+    }
+
+    T &at(size_t i) {
+        if (i >= size_) throw std::out_of_range("Out of range in buffer");
+        return objects_[physical(i)];
+    }
+
+    T &front() {
+        return objects_[head_];
+    }
+
+    [[nodiscard]] const T &front() const {
+        return objects_[head_];
+    }
+
+    T &back() {
+        return objects_[physical(size_ - 1)];
+    }
+
+    [[nodiscard]] const T &back() const {
+        return objects_[physical(size_ - 1)];
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return capacity_;
+    }
+
+    [[nodiscard]] size_t max_size() const {
+        return UINT32_MAX;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    std::span<T> first_segment() {
+        return {objects_ + head_, std::min<size_t>(size_, capacity_ - head_)};
+    }
+
+    [[nodiscard]] std::span<const T> first_segment() const {
+        return {objects_ + head_, std::min<size_t>(size_, capacity_ - head_)};
+    }
+
+    std::span<T> second_segment() {
+        return {objects_, size_ - first_segment().size()};
+    }
+
+    [[nodiscard]] std::span<const T> second_segment() const {
+        return {objects_, size_ - first_segment().size()};
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, size_);
+    }
+
+    [[nodiscard]] const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+
+    [[nodiscard]] const_iterator cend() const {
+        return const_iterator(this, size_);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(cend());
+    }
+
+    [[nodiscard]] const_reverse_iterator crend() const {
+        return const_reverse_iterator(cbegin());
+    }
+};
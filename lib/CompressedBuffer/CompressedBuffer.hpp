@@ -0,0 +1,378 @@
+#pragma once
+
+#include "../StaticBuffer/StaticBuffer.hpp"
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+struct BitWriter {
+    std::vector<uint8_t> bytes;
+    unsigned free_bits = 0;
+
+    void write(uint64_t value, unsigned bits) {
+        while (bits > 0) {
+            if (free_bits == 0) {
+                bytes.push_back(0);
+                free_bits = 8;
+            }
+            unsigned n = std::min(bits, free_bits);
+            auto chunk = static_cast<uint8_t>((value >> (bits - n)) & ((1u << n) - 1));
+            bytes.back() |= chunk << (free_bits - n);
+            free_bits -= n;
+            bits -= n;
+        }
+    }
+};
+
+struct BitReader {
+    const uint8_t *data = nullptr;
+    size_t pos = 0;
+
+    uint64_t read(unsigned bits) {
+        uint64_t value = 0;
+        while (bits > 0) {
+            unsigned avail = 8 - pos % 8;
+            unsigned n = std::min(bits, avail);
+            uint64_t chunk = (data[pos / 8] >> (avail - n)) & ((1u << n) - 1);
+            value = (value << n) | chunk;
+            pos += n;
+            bits -= n;
+        }
+        return value;
+    }
+};
+
+// Gorilla delta-of-delta encoding: regular intervals cost one bit per timestamp.
+struct TimestampCodec {
+    uint64_t prev = 0;
+    uint64_t prev_delta = 0;
+    bool first = true;
+
+    void encode(BitWriter &w, int64_t timestamp) {
+        auto ts = static_cast<uint64_t>(timestamp);
+        if (first) {
+            w.write(ts, 64);
+            prev = ts;
+            first = false;
+            return;
+        }
+        uint64_t delta = ts - prev;
+        auto dod = static_cast<int64_t>(delta - prev_delta);
+        prev = ts;
+        prev_delta = delta;
+        if (dod == 0) {
+            w.write(0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            w.write(0b10, 2);
+            w.write(dod + 63, 7);
+        } else if (dod >= -255 && dod <= 256) {
+            w.write(0b110, 3);
+            w.write(dod + 255, 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            w.write(0b1110, 4);
+            w.write(dod + 2047, 12);
+        } else {
+            w.write(0b1111, 4);
+            w.write(static_cast<uint64_t>(dod), 64);
+        }
+    }
+
+    int64_t decode(BitReader &r) {
+        if (first) {
+            prev = r.read(64);
+            first = false;
+            return static_cast<int64_t>(prev);
+        }
+        int64_t dod;
+        if (r.read(1) == 0) dod = 0;
+        else if (r.read(1) == 0) dod = static_cast<int64_t>(r.read(7)) - 63;
+        else if (r.read(1) == 0) dod = static_cast<int64_t>(r.read(9)) - 255;
+        else if (r.read(1) == 0) dod = static_cast<int64_t>(r.read(12)) - 2047;
+        else dod = static_cast<int64_t>(r.read(64));
+        prev_delta += static_cast<uint64_t>(dod);
+        prev += prev_delta;
+        return static_cast<int64_t>(prev);
+    }
+};
+
+template<typename T>
+struct ValueCodec;
+
+// Gorilla XOR encoding: only the meaningful bits of the xor with the previous value are stored.
+template<>
+struct ValueCodec<double> {
+    uint64_t prev = 0;
+    unsigned leading = 65;
+    unsigned trailing = 0;
+    bool first = true;
+
+    void encode(BitWriter &w, double value) {
+        auto bits = std::bit_cast<uint64_t>(value);
+        if (first) {
+            w.write(bits, 64);
+            prev = bits;
+            first = false;
+            return;
+        }
+        uint64_t x = bits ^ prev;
+        prev = bits;
+        if (x == 0) {
+            w.write(0, 1);
+            return;
+        }
+        w.write(1, 1);
+        unsigned lz = std::min(std::countl_zero(x), 31);
+        unsigned tz = std::countr_zero(x);
+        if (leading <= 64 && lz >= leading && tz >= trailing) {
+            w.write(0, 1);
+            w.write(x >> trailing, 64 - leading - trailing);
+            return;
+        }
+        leading = lz;
+        trailing = tz;
+        unsigned len = 64 - lz - tz;
+        w.write(1, 1);
+        w.write(lz, 5);
+        w.write(len - 1, 6);
+        w.write(x >> tz, len);
+    }
+
+    double decode(BitReader &r) {
+        if (first) {
+            prev = r.read(64);
+            first = false;
+            return std::bit_cast<double>(prev);
+        }
+        if (r.read(1) == 1) {
+            if (r.read(1) == 1) {
+                leading = r.read(5);
+                trailing = 64 - leading - (r.read(6) + 1);
+            }
+            prev ^= r.read(64 - leading - trailing) << trailing;
+        }
+        return std::bit_cast<double>(prev);
+    }
+};
+
+// Delta + zigzag + varint encoding for integers.
+template<>
+struct ValueCodec<int64_t> {
+    uint64_t prev = 0;
+    bool first = true;
+
+    void encode(BitWriter &w, int64_t value) {
+        auto bits = static_cast<uint64_t>(value);
+        if (first) {
+            w.write(bits, 64);
+            prev = bits;
+            first = false;
+            return;
+        }
+        uint64_t delta = bits - prev;
+        prev = bits;
+        uint64_t z = (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+        while (z >= 0x80) {
+            w.write((z & 0x7f) | 0x80, 8);
+            z >>= 7;
+        }
+        w.write(z, 8);
+    }
+
+    int64_t decode(BitReader &r) {
+        if (first) {
+            prev = r.read(64);
+            first = false;
+            return static_cast<int64_t>(prev);
+        }
+        uint64_t z = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            uint64_t byte = r.read(8);
+            z |= (byte & 0x7f) << shift;
+            if (byte < 0x80) break;
+        }
+        prev += (z >> 1) ^ (~(z & 1) + 1);
+        return static_cast<int64_t>(prev);
+    }
+};
+
+// Ring of compressed fixed-size blocks. The newest block is kept uncompressed as well
+// for random access; when it fills up it is sealed and the oldest block is evicted.
+template<typename T>
+class CompressedBuffer {
+public:
+    struct Sample {
+        int64_t timestamp;
+        T value;
+
+        bool operator==(const Sample &other) const = default;
+    };
+
+private:
+    struct Block {
+        std::vector<uint8_t> bytes;
+        size_t count = 0;
+    };
+
+    struct Encoder {
+        BitWriter writer;
+        TimestampCodec timestamps;
+        ValueCodec<T> values;
+
+        void encode(const Sample &sample) {
+            timestamps.encode(writer, sample.timestamp);
+            values.encode(writer, sample.value);
+        }
+    };
+
+    struct Decoder {
+        BitReader reader;
+        TimestampCodec timestamps;
+        ValueCodec<T> values;
+
+        Sample decode() {
+            int64_t timestamp = timestamps.decode(reader);
+            return {timestamp, values.decode(reader)};
+        }
+    };
+
+    size_t block_size_;
+    StaticBuffer<Block> blocks_;
+    std::vector<Sample> tail_;
+    Encoder open_;
+    size_t size_ = 0;
+
+public:
+    // Decodes into the iterator itself, so references die with it: an input iterator.
+    class const_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Sample;
+        using pointer = const Sample *;
+        using reference = const Sample &;
+
+    private:
+        const CompressedBuffer *buffer_;
+        size_t block_;
+        size_t index_;
+        Decoder decoder_;
+        Sample current_{};
+
+        void load() {
+            if (block_ < buffer_->blocks_.size()) {
+                decoder_ = Decoder();
+                decoder_.reader.data = buffer_->blocks_[block_].bytes.data();
+                current_ = decoder_.decode();
+            } else if (index_ < buffer_->tail_.size()) {
+                current_ = buffer_->tail_[index_];
+            }
+        }
+
+    public:
+        const_iterator(const CompressedBuffer *buf, size_t block, size_t index)
+                : buffer_(buf), block_(block), index_(index) {
+            load();
+        }
+
+        const Sample &operator*() const {
+            return current_;
+        }
+
+        const Sample *operator->() const {
+            return &current_;
+        }
+
+        const_iterator &operator++() {
+            ++index_;
+            if (block_ < buffer_->blocks_.size()) {
+                if (index_ < buffer_->blocks_[block_].count) {
+                    current_ = decoder_.decode();
+                    return *this;
+                }
+                ++block_;
+                index_ = 0;
+                load();
+            } else if (index_ < buffer_->tail_.size()) {
+                current_ = buffer_->tail_[index_];
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator &iter) const {
+            return block_ == iter.block_ && index_ == iter.index_;
+        }
+
+        bool operator!=(const const_iterator &iter) const {
+            return !(*this == iter);
+        }
+    };
+
+    explicit CompressedBuffer(size_t max_blocks, size_t block_size = 256)
+            : block_size_(block_size), blocks_(max_blocks) {
+        if (max_blocks == 0 || block_size == 0) throw std::out_of_range("zero capacity");
+        tail_.reserve(block_size_);
+    }
+
+    void push_back(int64_t timestamp, const T &value) {
+        Sample sample{timestamp, value};
+        open_.encode(sample);
+        tail_.push_back(sample);
+        ++size_;
+        if (tail_.size() == block_size_) seal();
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] size_t block_count() const {
+        return blocks_.size();
+    }
+
+    [[nodiscard]] size_t memory_usage() const {
+        size_t bytes = tail_.capacity() * sizeof(Sample) + open_.writer.bytes.capacity();
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+            bytes += blocks_[i].bytes.capacity() + sizeof(Block);
+        }
+        return bytes;
+    }
+
+    // i-th newest sample, only for the uncompressed tail.
+    const Sample &recent(size_t i) const {
+        if (i >= tail_.size()) throw std::out_of_range("sample is not in the uncompressed tail");
+        return tail_[tail_.size() - 1 - i];
+    }
+
+    [[nodiscard]] const_iterator begin() const {
+        return const_iterator(this, 0, 0);
+    }
+
+    [[nodiscard]] const_iterator end() const {
+        return const_iterator(this, blocks_.size(), tail_.size());
+    }
+
+private:
+    void seal() {
+        if (blocks_.size() == blocks_.capacity()) {
+            size_ -= blocks_.front().count;
+            blocks_.pop_front();
+        }
+        Block block;
+        block.bytes = std::move(open_.writer.bytes);
+        block.bytes.shrink_to_fit();
+        block.count = tail_.size();
+        blocks_.push_back(std::move(block));
+        open_ = Encoder();
+        tail_.clear();
+    }
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+// Immutable linear copy of a buffer; copies of a snapshot share the same storage.
+template<typename T>
+class BufferSnapshot {
+private:
+    std::shared_ptr<const std::vector<T>> data_;
+
+public:
+    BufferSnapshot() : data_(std::make_shared<const std::vector<T>>()) {}
+
+    explicit BufferSnapshot(std::vector<T> data) : data_(std::make_shared<const std::vector<T>>(std::move(data))) {}
+
+    [[nodiscard]] const T *begin() const {
+        return data_->data();
+    }
+
+    [[nodiscard]] const T *end() const {
+        return data_->data() + data_->size();
+    }
+
+    [[nodiscard]] std::span<const T> span() const {
+        return {begin(), end()};
+    }
+
+    [[nodiscard]] size_t size() const {
+        return data_->size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return data_->empty();
+    }
+
+    const T &operator[](size_t i) const {
+        return (*data_)[i];
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+struct no_generation {
+    constexpr no_generation &operator++() {
+        return *this;
+    }
+
+    bool operator==(const no_generation &) const = default;
+};
+
+// Plain pointer stepping: no range checks and no buffer reads on dereference.
+struct unchecked_policy {
+    static constexpr bool checked = false;
+    using generation_type = no_generation;
+};
+
+// Range checks on dereference and on iterator arithmetic.
+struct checked_policy {
+    static constexpr bool checked = true;
+    using generation_type = no_generation;
+};
+
+// Range checks plus detection of iterators invalidated by reserve.
+struct hardened_policy {
+    static constexpr bool checked = true;
+    using generation_type = size_t;
+};
+
+// Checked in every build type; unchecked_policy is an explicit opt-in.
+using default_checking_policy = checked_policy;
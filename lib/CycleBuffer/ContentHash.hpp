@@ -0,0 +1,60 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Streaming hash over bytes: feeding the same bytes in any number of pieces gives the same
+// result, so a buffer hashes the same whatever its wrap position.
+class ContentHash {
+private:
+    uint64_t state_ = 0x9e3779b97f4a7c15ULL;
+    uint64_t pending_ = 0;
+    size_t pending_size_ = 0;
+    size_t length_ = 0;
+
+    void mix(uint64_t word) {
+        state_ ^= word * 0xff51afd7ed558ccdULL;
+        state_ = std::rotl(state_, 29) * 0xc4ceb9fe1a85ec53ULL;
+    }
+
+public:
+    void update(const void *data, size_t n) {
+        auto bytes = static_cast<const unsigned char *>(data);
+        length_ += n;
+        while (n > 0 && pending_size_ != 0) {
+            pending_ |= uint64_t(*bytes++) << (8 * pending_size_++);
+            --n;
+            if (pending_size_ == 8) {
+                mix(pending_);
+                pending_ = 0;
+                pending_size_ = 0;
+            }
+        }
+        for (; n >= 8; n -= 8, bytes += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            if constexpr (std::endian::native == std::endian::big) word = __builtin_bswap64(word);
+            mix(word);
+        }
+        while (n > 0) {
+            pending_ |= uint64_t(*bytes++) << (8 * pending_size_++);
+            --n;
+        }
+    }
+
+    void update(uint64_t value) {
+        update(&value, sizeof(value));
+    }
+
+    [[nodiscard]] size_t finish() const {
+        uint64_t h = state_;
+        h ^= pending_ * 0x9e3779b97f4a7c15ULL;
+        h ^= length_;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+};
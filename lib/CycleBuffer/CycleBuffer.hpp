@@ -1,17 +1,27 @@
 #pragma once
 
+#include "BufferSnapshot.hpp"
+#include "CheckingPolicy.hpp"
+#include "ContentHash.hpp"
+#include "InlineStorage.hpp"
+#include <algorithm>
+#include <compare>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <span>
+#include <stdexcept>
+#include <functional>
 
-template<typename T, typename Alloc = std::allocator<T>>
+template<typename T, typename Alloc = std::allocator<T>, typename Checking = default_checking_policy>
 class CycleBuffer;
 
-template<typename T, typename Alloc = std::allocator<T>>
-std::ostream &operator<<(std::ostream &out, CycleBuffer<T, Alloc> &v);
+template<typename T, typename Alloc = std::allocator<T>, typename Checking = default_checking_policy>
+std::ostream &operator<<(std::ostream &out, CycleBuffer<T, Alloc, Checking> &v);
 
 
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Checking>
 
 class CycleBuffer {
 protected:
@@ -20,6 +30,11 @@ protected:
     T *objects_;
     T *begin_;
     T *end_;
+    [[no_unique_address]] typename Checking::generation_type generation_{};
+
+    // One extra slot for the end sentinel, as in every allocation below.
+    static constexpr size_t inline_slots_ = inline_capacity_of<Alloc>::value ? inline_capacity_of<Alloc>::value + 1 : 0;
+    [[no_unique_address]] InlineStorage<T, inline_slots_> inline_;
 
     template<bool ConstFlag>
     class Common_iterator {
@@ -31,100 +46,116 @@ protected:
         using reference = value_type &;
 
     private:
-        std::conditional_t<ConstFlag, const CycleBuffer<T, Alloc> *, CycleBuffer<T, Alloc> *> buffer_;
+        std::conditional_t<ConstFlag, const CycleBuffer *, CycleBuffer *> buffer_;
         std::conditional_t<ConstFlag, const T *, T *> current_;
+        [[no_unique_address]] typename Checking::generation_type generation_;
+
+        constexpr void check_generation() const {
+            if (generation_ != buffer_->generation_) throw std::logic_error("iterator invalidated by reserve");
+        }
 
     public:
-        Common_iterator(std::conditional_t<ConstFlag, const CycleBuffer<T, Alloc> *, CycleBuffer<T, Alloc> *> buf,
-                        T *cur) {
+        constexpr Common_iterator(std::conditional_t<ConstFlag, const CycleBuffer *, CycleBuffer *> buf, T *cur) {
             buffer_ = buf;
             current_ = cur;
+            generation_ = buf->generation_;
         }
 
-        Common_iterator(const Common_iterator &other) : current_(other.current_), buffer_(other.buffer_) {}
+        constexpr Common_iterator(const Common_iterator &other)
+                : buffer_(other.buffer_), current_(other.current_), generation_(other.generation_) {}
 
-        std::conditional_t<ConstFlag, const T &, T &> operator*() {
-            if (current_ == buffer_->end_) throw std::out_of_range("out of range");
+        Common_iterator &operator=(const Common_iterator &other) = default;
+
+        constexpr std::conditional_t<ConstFlag, const T &, T &> operator*() {
+            if constexpr (Checking::checked) {
+                check_generation();
+                if (current_ == buffer_->end_) throw std::out_of_range("out of range");
+            }
             return *(this->current_);
         }
 
-        std::conditional_t<ConstFlag, const T *, T *> operator->() {
+        constexpr std::conditional_t<ConstFlag, const T *, T *> operator->() {
             return this->current_;
         }
 
-        void swap(Common_iterator &other) {
+        constexpr void swap(Common_iterator &other) {
             std::swap(buffer_, other.buffer_);
             std::swap(current_, other.current_);
+            std::swap(generation_, other.generation_);
         }
 
-        bool operator==(const Common_iterator &iter) {
+        constexpr bool operator==(const Common_iterator &iter) {
             return this->current_ == iter.current_;
         }
 
-        bool operator!=(const Common_iterator &iter) {
+        constexpr bool operator!=(const Common_iterator &iter) {
             return this->current_ != iter.current_;
         }
 
-        Common_iterator &operator+=(int i) {
-            while (i < 0) {
-                i += buffer_->capacity_;
-            }
-            i = i % buffer_->capacity_;
-            if (i < 0) i += buffer_->capacity_;
-            else if (i == 0) return *this;
-            if (current_ + i > buffer_->objects_ + buffer_->capacity_ - 1) {
-                i -= buffer_->objects_ + buffer_->capacity_ - current_;
-                current_ = buffer_->objects_;
+        constexpr Common_iterator &operator+=(int i) {
+            if constexpr (!Checking::checked) {
+                difference_type cap = buffer_->capacity_;
+                difference_type pos = current_ - buffer_->objects_ + i;
+                if (pos >= cap) pos -= cap;
+                else if (pos < 0) pos += cap;
+                if (pos >= cap || pos < 0) {
+                    pos %= cap;
+                    if (pos < 0) pos += cap;
+                }
+                current_ = buffer_->objects_ + pos;
+                return *this;
             }
-            current_ += i;
-            if ((current_ > buffer_->end_ && current_ < buffer_->begin_ && buffer_->end_ < buffer_->begin_) &&
-                !(current_ >= buffer_->begin_ && current_ <= buffer_->end_ && buffer_->end_ >= buffer_->begin_)) {
+            check_generation();
+            difference_type cap = buffer_->capacity_;
+            if (i % cap == 0) return *this;
+            difference_type pos = ((current_ - buffer_->objects_ + i % cap) % cap + cap) % cap;
+            current_ = buffer_->objects_ + pos;
+            if (buffer_->end_ < buffer_->begin_ && current_ > buffer_->end_ && current_ < buffer_->begin_) {
                 throw std::out_of_range("out of container");
             }
             return *this;
-
         }
 
-        Common_iterator &operator-=(int i) {
+        constexpr Common_iterator &operator-=(int i) {
             return (*this) += -i;
         }
 
-        Common_iterator &operator++() {
+        constexpr Common_iterator &operator++() {
             return (*this) += 1;
         }
 
-        Common_iterator &operator--() {
+        constexpr Common_iterator &operator--() {
             return (*this) -= 1;
         }
 
 
-        Common_iterator operator--(int) {
+        constexpr Common_iterator operator--(int) {
             Common_iterator temp = *this;
             --(*this);
             return temp;
         }
 
-        Common_iterator operator++(int) {
+        constexpr Common_iterator operator++(int) {
             Common_iterator temp = *this;
             ++(*this);
             return temp;
         }
 
-        Common_iterator operator+(int i) {
+        constexpr Common_iterator operator+(int i) {
             Common_iterator temp = *this;
             return temp += i;
         }
 
-        Common_iterator operator-(int i) {
+        constexpr Common_iterator operator-(int i) {
             Common_iterator temp = *this;
             return temp -= i;
         }
 
-        Common_iterator &operator[](size_t i) {
+        constexpr Common_iterator &operator[](size_t i) {
             return *((*this) + i);
         }
 
-        bool operator<(const Common_iterator &iter) const {
+        constexpr bool operator<(const Common_iterator &iter) const {
             if (buffer_->end_ > buffer_->begin_) return this->current_ < iter.current_;
             if ((this->current_ <= this->buffer_->end_ && iter.current_ <= this->buffer_->end_) ||
                 (this->current_ >= this->buffer_->begin_ && iter.current_ >= this->buffer_->begin_))
@@ -132,7 +163,7 @@ protected:
             return iter.current_ < this->current_;
         }
 
-        difference_type operator-(const Common_iterator &iter) const {
+        constexpr difference_type operator-(const Common_iterator &iter) const {
             if (buffer_->end_ > buffer_->begin_) return this->current_ - iter.current_;
             if ((this->current_ <= this->buffer_->end_ && iter.current_ <= this->buffer_->end_) ||
                 (this->current_ >= this->buffer_->begin_ && iter.current_ >= this->buffer_->begin_))
@@ -141,21 +172,135 @@ protected:
             return this->current_ - iter.current_ + this->buffer_->capacity_;
         }
 
-        bool operator<=(const Common_iterator &iter) const {
+        constexpr bool operator<=(const Common_iterator &iter) const {
             return (*this) < iter || (*this) == iter;
         }
 
 
-        bool operator>=(const Common_iterator &iter) const {
+        constexpr bool operator>=(const Common_iterator &iter) const {
             return iter <= (*this);
         }
 
-        bool operator>(const Common_iterator &iter) const {
+        constexpr bool operator>(const Common_iterator &iter) const {
             return iter < (*this);
         }
     };
 
-    friend std::ostream &operator<<<>(std::ostream &out, CycleBuffer<T, Alloc> &v);
+    friend std::ostream &operator<<<>(std::ostream &out, CycleBuffer<T, Alloc, Checking> &v);
+
+    constexpr T *allocate_storage(size_t n) {
+        if (n <= inline_slots_ && !is_inline()) return inline_.data();
+        return allocator_traits::allocate(alloc, n);
+    }
+
+    constexpr void deallocate_storage(T *p, size_t n) {
+        if (inline_slots_ != 0 && p == inline_.data()) return;
+        allocator_traits::deallocate(alloc, p, n);
+    }
+
+    constexpr void destroy_elements() {
+        if (objects_ == nullptr) return;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            auto first = first_segment();
+            auto second = second_segment();
+            std::destroy(first.begin(), first.end());
+            std::destroy(second.begin(), second.end());
+        }
+    }
+
+    // Walks two buffers in step and calls f on every pair of contiguous chunks of equal length,
+    // up to the shorter size, while f returns true.
+    template<typename F>
+    static constexpr void for_each_chunk(const CycleBuffer &a, const CycleBuffer &b, F f) {
+        std::span<const T> sa[2] = {a.first_segment(), a.second_segment()};
+        std::span<const T> sb[2] = {b.first_segment(), b.second_segment()};
+        size_t ia = 0, ib = 0, oa = 0, ob = 0;
+        while (ia < 2 && ib < 2) {
+            if (oa == sa[ia].size()) {
+                ++ia;
+                oa = 0;
+                continue;
+            }
+            if (ob == sb[ib].size()) {
+                ++ib;
+                ob = 0;
+                continue;
+            }
+            size_t n = std::min(sa[ia].size() - oa, sb[ib].size() - ob);
+            if (!f(sa[ia].data() + oa, sb[ib].data() + ob, n)) return;
+            oa += n;
+            ob += n;
+        }
+    }
+
+    static constexpr T *copy_segments(const CycleBuffer &src, T *dst) {
+        auto first = src.first_segment();
+        auto second = src.second_segment();
+        // memcpy and uninitialized_copy are not usable in constant evaluation.
+        if (std::is_constant_evaluated()) {
+            for (const T &x: first) std::construct_at(dst++, x);
+            for (const T &x: second) std::construct_at(dst++, x);
+            return dst;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!first.empty()) std::memcpy(dst, first.data(), first.size_bytes());
+            if (!second.empty()) std::memcpy(dst + first.size(), second.data(), second.size_bytes());
+            return dst + first.size() + second.size();
+        } else {
+            T *mid = std::uninitialized_copy(first.begin(), first.end(), dst);
+            try {
+                return std::uninitialized_copy(second.begin(), second.end(), mid);
+            }
+            catch (...) {
+                std::destroy(dst, mid);
+                throw;
+            }
+        }
+    }
+
+    // This buffer is inline and heap is not: the elements move into heap's unused inline
+    // storage and this buffer takes over heap's allocation.
+    constexpr void move_inline_to(CycleBuffer &heap) {
+        T *dst = heap.inline_.data();
+        size_t n = 0;
+        for (auto seg: {first_segment(), second_segment()}) {
+            for (T &x: seg) {
+                std::construct_at(dst + n++, std::move(x));
+                std::destroy_at(&x);
+            }
+        }
+        size_t cap = capacity_;
+        objects_ = heap.objects_;
+        begin_ = heap.begin_;
+        end_ = heap.end_;
+        capacity_ = heap.capacity_;
+        heap.objects_ = heap.begin_ = dst;
+        heap.end_ = dst + n;
+        heap.capacity_ = cap;
+        ++generation_;
+        ++heap.generation_;
+    }
+
+    // Both buffers are inline: swap the common prefix, then move the rest of the longer one.
+    constexpr void swap_inline(CycleBuffer &other) {
+        linearize();
+        other.linearize();
+        CycleBuffer *shorter = this;
+        CycleBuffer *longer = &other;
+        if (shorter->size() > longer->size()) std::swap(shorter, longer);
+        size_t m = shorter->size();
+        size_t n = longer->size();
+        std::swap_ranges(shorter->objects_, shorter->objects_ + m, longer->objects_);
+        for (size_t i = m; i < n; ++i) {
+            std::construct_at(shorter->objects_ + i, std::move(longer->objects_[i]));
+            std::destroy_at(longer->objects_ + i);
+        }
+        shorter->end_ = shorter->objects_ + n;
+        longer->end_ = longer->objects_ + m;
+        std::swap(capacity_, other.capacity_);
+        ++generation_;
+        ++other.generation_;
+    }
 
 public:
     using iterator = Common_iterator<false>;
@@ -165,29 +310,36 @@ public:
     using allocator_traits = typename std::allocator_traits<Alloc>;
 
 
-    void reserve(size_t n) {
+    constexpr void reserve(size_t n) {
         if (n < capacity_) return;
-        T *new_obj = allocator_traits::allocate(alloc, n + 1);
+        if (is_inline() && n + 1 <= inline_slots_) {
+            // Still fits the inline storage: straighten the elements and widen in place.
+            linearize();
+            capacity_ = n + 1;
+            ++generation_;
+            return;
+        }
+        T *new_obj = allocate_storage(n + 1);
+        T *new_end = new_obj;
         if (objects_ != nullptr) {
             try {
-                std::uninitialized_copy(begin(), end(), new_obj);
+                new_end = copy_segments(*this, new_obj);
             }
             catch (...) {
-                allocator_traits::deallocate(alloc, new_obj, n + 1);
+                deallocate_storage(new_obj, n + 1);
                 throw;
             }
+            destroy_elements();
+            deallocate_storage(objects_, capacity_);
         }
 
-        for (auto temp = begin(); temp != end(); ++temp) {
-            std::destroy_at(temp.operator->());
-        }
-        end_ = new_obj + size();
-
+        end_ = new_end;
         begin_ = objects_ = new_obj;
         capacity_ = n + 1;
+        ++generation_;
     }
 
-    void resize(size_t n, const T &element = T()) {
+    constexpr void resize(size_t n, const T &element = T()) {
         if (capacity_ < n) reserve(n);
         for (; size() < n;) {
             std::construct_at(end_, element);
@@ -195,158 +347,321 @@ public:
         }
     }
 
-    CycleBuffer() : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
-        reserve(1);
+    constexpr CycleBuffer() : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
+        reserve(inline_slots_ ? inline_slots_ - 1 : 1);
     }
 
-    CycleBuffer(const CycleBuffer &other) {
-        this->reserve(other.capacity_);
-        std::uninitialized_copy(other.cbegin(), other.cend(), objects_);
-        begin_ = objects_;
-        end_ = objects_ + other.size();
+    constexpr CycleBuffer(const CycleBuffer &other)
+            : capacity_(0), alloc(allocator_traits::select_on_container_copy_construction(other.alloc)),
+              objects_(nullptr), begin_(nullptr), end_(nullptr) {
+        this->reserve(other.capacity());
+        try {
+            end_ = copy_segments(other, objects_);
+        }
+        catch (...) {
+            deallocate_storage(objects_, capacity_);
+            throw;
+        }
     }
 
-    CycleBuffer &operator=(const CycleBuffer &other) {
+    constexpr CycleBuffer &operator=(const CycleBuffer &other) {
         if (this == &other) return *this;
 
-        if (objects_ != nullptr) {
-            for (auto it = begin(); it != end(); ++it) {
-                std::destroy_at(it.operator->());
+        destroy_elements();
+        begin_ = end_ = objects_;
+        if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc != other.alloc && objects_ != nullptr) {
+                deallocate_storage(objects_, capacity_);
+                objects_ = begin_ = end_ = nullptr;
+                capacity_ = 0;
             }
-            allocator_traits::deallocate(alloc, objects_, capacity_);
+            alloc = other.alloc;
         }
-        reserve(other.capacity_);
-        std::uninitialized_copy(other.begin(), other.end(), objects_);
-        begin_ = objects_;
-        end_ = objects_ + other.size();
+        if (objects_ == nullptr || capacity() < other.size()) {
+            reserve(other.capacity());
+        }
+        end_ = copy_segments(other, objects_);
 
         return *this;
     };
 
-    explicit CycleBuffer(size_t c) : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
+    constexpr explicit CycleBuffer(size_t c) : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
         this->reserve(c);
     }
 
-    CycleBuffer(size_t c, const T &element) : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
+    constexpr CycleBuffer(size_t c, const T &element) : objects_(nullptr), begin_(nullptr), end_(nullptr), capacity_(0) {
         this->resize(c, element);
     }
 
-    ~CycleBuffer() {
+    constexpr ~CycleBuffer() {
         if (objects_ == nullptr) return;
 
-        for (auto it = begin(); it != end(); ++it) {
-            std::destroy_at(it.operator->());
-        }
-
-        allocator_traits::deallocate(alloc, objects_, capacity_);
+        destroy_elements();
+        deallocate_storage(objects_, capacity_);
         objects_ = nullptr;
     }
 
-    bool operator==(const CycleBuffer &other) const {
+    constexpr bool operator==(const CycleBuffer &other) const {
         if (this->size() != other.size()) return false;
-        auto it = other.begin();
-        for (auto i = this->begin; i < this->end(); ++i) {
-            if (*i != *it) return false;
-            ++it;
+        bool equal = true;
+        for_each_chunk(*this, other, [&](const T *a, const T *b, size_t n) {
+            if constexpr (std::has_unique_object_representations_v<T>) {
+                if (!std::is_constant_evaluated()) {
+                    equal = std::memcmp(a, b, n * sizeof(T)) == 0;
+                    return equal;
+                }
+            }
+            equal = std::equal(a, a + n, b);
+            return equal;
+        });
+        return equal;
+    }
+
+    constexpr bool operator!=(const CycleBuffer &other) const {
+        return !(*this == other);
+    }
+
+    constexpr auto operator<=>(const CycleBuffer &other) const requires std::three_way_comparable<T> {
+        std::compare_three_way_result_t<T> result = std::strong_ordering::equal;
+        for_each_chunk(*this, other, [&](const T *a, const T *b, size_t n) {
+            result = std::lexicographical_compare_three_way(a, a + n, b, b + n);
+            return result == 0;
+        });
+        if (result != 0) return result;
+        return std::compare_three_way_result_t<T>(this->size() <=> other.size());
+    }
+
+    [[nodiscard]] size_t hash() const {
+        ContentHash h;
+        for (auto seg: {first_segment(), second_segment()}) {
+            if constexpr (std::has_unique_object_representations_v<T>) {
+                h.update(seg.data(), seg.size_bytes());
+            } else {
+                for (const T &x: seg) {
+                    h.update(static_cast<uint64_t>(std::hash<T>()(x)));
+                }
+            }
         }
-        return true;
+        return h.finish();
     }
 
-    bool operator!=(const CycleBuffer &other) const {
-        return *this != other;
+    constexpr iterator find(const T &element) {
+        auto first = first_segment();
+        T *p = std::find(first.data(), first.data() + first.size(), element);
+        if (p != first.data() + first.size()) return iterator(this, p);
+        auto second = second_segment();
+        p = std::find(second.data(), second.data() + second.size(), element);
+        return p == second.data() + second.size() ? end() : iterator(this, p);
     }
 
-    T &operator[](size_t i) {
+    [[nodiscard]] constexpr bool contains(const T &element) const {
+        for (auto seg: {first_segment(), second_segment()}) {
+            if (std::find(seg.data(), seg.data() + seg.size(), element) != seg.data() + seg.size()) return true;
+        }
+        return false;
+    }
+
+    // First occurrence of [f, l); matches that cross the wrap point are checked separately
+    // so both segments are searched as plain arrays.
+    template<typename ForwardIt>
+    constexpr iterator search(ForwardIt f, ForwardIt l) {
+        auto first = first_segment();
+        auto second = second_segment();
+        size_t m = std::distance(f, l);
+        if (m == 0) return begin();
+        T *p = std::search(first.data(), first.data() + first.size(), f, l);
+        if (p != first.data() + first.size()) return iterator(this, p);
+        if (!second.empty()) {
+            size_t from = first.size() >= m ? first.size() - m + 1 : 0;
+            for (size_t s = from; s < first.size(); ++s) {
+                size_t head = first.size() - s;
+                if (m - head > second.size()) continue;
+                ForwardIt mid = std::next(f, head);
+                if (std::equal(first.data() + s, first.data() + first.size(), f, mid) &&
+                    std::equal(mid, l, second.data())) {
+                    return iterator(this, first.data() + s);
+                }
+            }
+        }
+        p = std::search(second.data(), second.data() + second.size(), f, l);
+        return p == second.data() + second.size() ? end() : iterator(this, p);
+    }
+
+    constexpr T &operator[](size_t i) {
         return *(this->begin() + i);
     }
 
-    T &at(size_t i) {
+    constexpr const T &operator[](size_t i) const {
+        return *(this->cbegin() + i);
+    }
+
+    constexpr T &at(size_t i) {
         if (i < 0 || i > capacity_) {
             throw std::out_of_range("Out of range in buffer");
         }
         return *(this->begin() + i);
     }
 
-    void swap(CycleBuffer &other) {
+    // Inline storage cannot change owners, so its elements are moved instead of the pointers;
+    // nothing is allocated, and only a throwing move of T can make this throw.
+    constexpr void swap(CycleBuffer &other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                     std::is_nothrow_swappable_v<T>) {
+        if (is_inline() && other.is_inline()) {
+            swap_inline(other);
+            return;
+        }
+        if (is_inline()) {
+            move_inline_to(other);
+            return;
+        }
+        if (other.is_inline()) {
+            other.move_inline_to(*this);
+            return;
+        }
         std::swap(begin_, other.begin_);
         std::swap(end_, other.end_);
         std::swap(objects_, other.objects_);
         std::swap(capacity_, other.capacity_);
     }
 
-    [[nodiscard]] bool empty() const {
+    [[nodiscard]] constexpr bool is_inline() const {
+        return inline_slots_ != 0 && objects_ == inline_.data();
+    }
+
+    [[nodiscard]] constexpr bool empty() const {
         return end_ == begin_ || objects_ == nullptr;
     }
 
-    [[nodiscard]] size_t capacity() const {
+    [[nodiscard]] constexpr size_t capacity() const {
         return capacity_ - 1;
     }
 
-    [[nodiscard]] size_t max_size() const {
+    [[nodiscard]] constexpr size_t max_size() const {
         return INT_MAX;
     };
 
-    [[nodiscard]] size_t size() const {
+    [[nodiscard]] constexpr size_t size() const {
         if (objects_ == nullptr || end_ == begin_) return 0;
         if (end_ > begin_) return end_ - begin_;
         return (end_ - objects_) + (objects_ + capacity_ - begin_);
     }
 
-    iterator begin() {
+    constexpr iterator begin() {
         return iterator(this, begin_);
     }
 
-    iterator end() {
+    constexpr iterator end() {
         return iterator(this, end_);
     }
 
-    [[nodiscard]] const_iterator cbegin() const {
+    [[nodiscard]] constexpr const_iterator cbegin() const {
         return const_iterator(this, begin_);
     }
 
-    [[nodiscard]] const_iterator cend() const {
+    [[nodiscard]] constexpr const_iterator cend() const {
         return const_iterator(this, end_);
     }
 
-    reverse_iterator rbegin() {
+    constexpr reverse_iterator rbegin() {
         return std::reverse_iterator(end());
     }
 
-    reverse_iterator rend() {
+    constexpr reverse_iterator rend() {
         return std::reverse_iterator(begin());
     }
 
-    [[nodiscard]] const_reverse_iterator crbegin() const {
+    [[nodiscard]] constexpr const_reverse_iterator crbegin() const {
         return const_reverse_iterator(end());
     }
 
-    [[nodiscard]] const_reverse_iterator crend() const {
+    [[nodiscard]] constexpr const_reverse_iterator crend() const {
         return const_reverse_iterator(begin());
     }
 
 
-    T &front() {
+    constexpr std::span<T> first_segment() {
+        if (end_ >= begin_) return {begin_, end_};
+        return {begin_, objects_ + capacity_};
+    }
+
+    [[nodiscard]] constexpr std::span<const T> first_segment() const {
+        if (end_ >= begin_) return {begin_, end_};
+        return {begin_, objects_ + capacity_};
+    }
+
+    constexpr std::span<T> second_segment() {
+        if (end_ >= begin_) return {};
+        return {objects_, end_};
+    }
+
+    [[nodiscard]] constexpr std::span<const T> second_segment() const {
+        if (end_ >= begin_) return {};
+        return {objects_, end_};
+    }
+
+    [[nodiscard]] BufferSnapshot<T> snapshot() const {
+        std::vector<T> data;
+        data.reserve(size());
+        for (auto seg: {first_segment(), second_segment()}) {
+            data.insert(data.end(), seg.begin(), seg.end());
+        }
+        return BufferSnapshot<T>(std::move(data));
+    }
+
+    [[nodiscard]] constexpr bool is_linearized() const {
+        return begin_ == objects_;
+    }
+
+    constexpr T *linearize() {
+        if (begin_ == objects_) return objects_;
+        size_t n = size();
+        if (end_ < begin_) {
+            size_t gap = begin_ - end_;
+            for (T *p = end_; p != objects_;) {
+                --p;
+                std::construct_at(p + gap, std::move(*p));
+                std::destroy_at(p);
+            }
+            std::rotate(objects_ + gap, begin_, objects_ + capacity_);
+            begin_ = objects_ + gap;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            std::construct_at(objects_ + i, std::move(begin_[i]));
+            std::destroy_at(begin_ + i);
+        }
+        begin_ = objects_;
+        end_ = objects_ + n;
+        return objects_;
+    }
+
+    constexpr T &front() {
         return *begin_;
     }
 
-    [[nodiscard]] const T &front() const {
+    [[nodiscard]] constexpr const T &front() const {
         return *begin_;
     }
 
-    T &back() {
-        return *(end_ - 1);
+    constexpr T &back() {
+        return *(end_ == objects_ ? objects_ + capacity_ - 1 : end_ - 1);
     }
 
-    [[nodiscard]] const T &back() const {
-        return *(end_ - 1);
+    [[nodiscard]] constexpr const T &back() const {
+        return *(end_ == objects_ ? objects_ + capacity_ - 1 : end_ - 1);
     }
 };
 
-template<typename T, typename Alloc>
-std::ostream &operator<<(std::ostream &out, CycleBuffer<T, Alloc> &v) {
+template<typename T, typename Alloc, typename Checking>
+std::ostream &operator<<(std::ostream &out, CycleBuffer<T, Alloc, Checking> &v) {
     for (auto i: v) {
         out << i << ' ';
     }
     return out;
 }
 
+template<typename T, typename Alloc, typename Checking>
+struct std::hash<CycleBuffer<T, Alloc, Checking>> {
+    size_t operator()(const CycleBuffer<T, Alloc, Checking> &buf) const {
+        return buf.hash();
+    }
+};
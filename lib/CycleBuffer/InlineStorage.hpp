@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Allocator that asks the buffer to keep up to N elements inside the object itself;
+// larger storage comes from std::allocator.
+template<typename T, size_t N>
+struct inline_allocator : std::allocator<T> {
+    static constexpr size_t inline_capacity = N;
+
+    template<typename U>
+    struct rebind {
+        using other = inline_allocator<U, N>;
+    };
+
+    inline_allocator() = default;
+
+    template<typename U>
+    inline_allocator(const inline_allocator<U, N> &) {}
+};
+
+template<typename Alloc, typename = void>
+struct inline_capacity_of : std::integral_constant<size_t, 0> {};
+
+template<typename Alloc>
+struct inline_capacity_of<Alloc, std::void_t<decltype(Alloc::inline_capacity)>>
+        : std::integral_constant<size_t, Alloc::inline_capacity> {};
+
+template<typename T, size_t Slots>
+struct InlineStorage {
+    alignas(T) unsigned char bytes[Slots * sizeof(T)];
+
+    T *data() {
+        return reinterpret_cast<T *>(bytes);
+    }
+
+    const T *data() const {
+        return reinterpret_cast<const T *>(bytes);
+    }
+};
+
+template<typename T>
+struct InlineStorage<T, 0> {
+    constexpr T *data() {
+        return nullptr;
+    }
+
+    constexpr const T *data() const {
+        return nullptr;
+    }
+};
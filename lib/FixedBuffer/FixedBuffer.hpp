@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../IndexIterator/IndexIterator.hpp"
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+// Ring of N elements stored inline in a std::array. It is a literal type when T is,
+// so a filled buffer can be a constexpr variable; all slots hold elements, without a sentinel.
+template<typename T, size_t N>
+class FixedBuffer {
+private:
+    std::array<T, N> objects_{};
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    [[nodiscard]] constexpr size_t physical(size_t i) const {
+        size_t pos = head_ + i;
+        return pos >= N ? pos - N : pos;
+    }
+
+public:
+    using value_type = T;
+    using iterator = IndexIterator<FixedBuffer, false>;
+    using const_iterator = IndexIterator<FixedBuffer, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    constexpr FixedBuffer() = default;
+
+    constexpr FixedBuffer(std::initializer_list<T> l) {
+        for (const T &x: l) {
+            push_back(x);
+        }
+    }
+
+    constexpr void push_back(const T &element) {
+        if (size_ == N) throw std::out_of_range("out of container");
+        objects_[physical(size_)] = element;
+        ++size_;
+    }
+
+    constexpr void push_front(const T &element) {
+        if (size_ == N) throw std::out_of_range("out of container");
+        head_ = head_ == 0 ? N - 1 : head_ - 1;
+        objects_[head_] = element;
+        ++size_;
+    }
+
+    constexpr void pop_back() {
+        if (size_ == 0) return;
+        --size_;
+        objects_[physical(size_)] = T();
+    }
+
+    constexpr void pop_front() {
+        if (size_ == 0) return;
+        objects_[head_] = T();
+        head_ = physical(1);
+        --size_;
+    }
+
+    constexpr void clear() {
+        while (size_ > 0) {
+            pop_back();
+        }
+        head_ = 0;
+    }
+
+    constexpr T &operator[](size_t i) {
+        return objects_[physical(i)];
+    }
+
+    constexpr const T &operator[](size_t i) const {
+        return objects_[physical(i)];
+    }
+
+    constexpr T &at(size_t i) {
+        if (i >= size_) throw std::out_of_range("Out of range in buffer");
+        return (*this)[i];
+    }
+
+    [[nodiscard]] constexpr const T &at(size_t i) const {
+        if (i >= size_) throw std::out_of_range("Out of range in buffer");
+        return (*this)[i];
+    }
+
+    constexpr T &front() {
+        return objects_[head_];
+    }
+
+    [[nodiscard]] constexpr const T &front() const {
+        return objects_[head_];
+    }
+
+    constexpr T &back() {
+        return objects_[physical(size_ - 1)];
+    }
+
+    [[nodiscard]] constexpr const T &back() const {
+        return objects_[physical(size_ - 1)];
+    }
+
+    [[nodiscard]] constexpr bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] constexpr bool full() const {
+        return size_ == N;
+    }
+
+    [[nodiscard]] constexpr size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() {
+        return N;
+    }
+
+    constexpr iterator begin() {
+        return iterator(this, 0);
+    }
+
+    constexpr iterator end() {
+        return iterator(this, size_);
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const {
+        return const_iterator(this, size_);
+    }
+
+    [[nodiscard]] constexpr const_iterator cbegin() const {
+        return begin();
+    }
+
+    [[nodiscard]] constexpr const_iterator cend() const {
+        return end();
+    }
+
+    constexpr reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    constexpr reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    [[nodiscard]] constexpr const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(cend());
+    }
+
+    [[nodiscard]] constexpr const_reverse_iterator crend() const {
+        return const_reverse_iterator(cbegin());
+    }
+
+    constexpr bool operator==(const FixedBuffer &other) const {
+        if (size_ != other.size_) return false;
+        for (size_t i = 0; i < size_; ++i) {
+            if (!((*this)[i] == other[i])) return false;
+        }
+        return true;
+    }
+};
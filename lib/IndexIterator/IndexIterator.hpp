@@ -0,0 +1,98 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Random access iterator over a container that addresses its elements by logical index.
+// It stores the container and an index and dereferences through Container::operator[], so it
+// stays valid while elements are pushed or popped at the far end and never has to know the layout.
+template<typename Container, bool ConstFlag>
+class IndexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename Container::value_type;
+    using pointer = std::conditional_t<ConstFlag, const value_type *, value_type *>;
+    using reference = std::conditional_t<ConstFlag, const value_type &, value_type &>;
+
+private:
+    std::conditional_t<ConstFlag, const Container *, Container *> container_;
+    difference_type index_;
+
+public:
+    constexpr IndexIterator() : container_(nullptr), index_(0) {}
+
+    constexpr IndexIterator(std::conditional_t<ConstFlag, const Container *, Container *> container,
+                            difference_type index) : container_(container), index_(index) {}
+
+    constexpr reference operator*() const {
+        return (*container_)[index_];
+    }
+
+    constexpr pointer operator->() const {
+        return std::addressof((*container_)[index_]);
+    }
+
+    constexpr reference operator[](difference_type i) const {
+        return (*container_)[index_ + i];
+    }
+
+    constexpr IndexIterator &operator+=(difference_type i) {
+        index_ += i;
+        return *this;
+    }
+
+    constexpr IndexIterator &operator-=(difference_type i) {
+        index_ -= i;
+        return *this;
+    }
+
+    constexpr IndexIterator &operator++() {
+        ++index_;
+        return *this;
+    }
+
+    constexpr IndexIterator &operator--() {
+        --index_;
+        return *this;
+    }
+
+    constexpr IndexIterator operator++(int) {
+        IndexIterator temp = *this;
+        ++index_;
+        return temp;
+    }
+
+    constexpr IndexIterator operator--(int) {
+        IndexIterator temp = *this;
+        --index_;
+        return temp;
+    }
+
+    constexpr IndexIterator operator+(difference_type i) const {
+        return IndexIterator(container_, index_ + i);
+    }
+
+    friend constexpr IndexIterator operator+(difference_type i, const IndexIterator &iter) {
+        return iter + i;
+    }
+
+    constexpr IndexIterator operator-(difference_type i) const {
+        return IndexIterator(container_, index_ - i);
+    }
+
+    constexpr difference_type operator-(const IndexIterator &iter) const {
+        return index_ - iter.index_;
+    }
+
+    constexpr bool operator==(const IndexIterator &iter) const {
+        return index_ == iter.index_;
+    }
+
+    constexpr auto operator<=>(const IndexIterator &iter) const {
+        return index_ <=> iter.index_;
+    }
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "../StaticBuffer/StaticBuffer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+struct fifo_eviction {
+    static constexpr bool second_chance = false;
+};
+
+struct clock_eviction {
+    static constexpr bool second_chance = true;
+};
+
+// Fixed-capacity cache: entries live in a StaticBuffer in insertion order, so the front of the
+// ring is the next eviction candidate, and are found through an open-addressing index that stores
+// ring sequence numbers. Erased entries stay in the ring as dead slots until they reach the front;
+// the ring holds twice the capacity, and when it fills up the dead slots are compacted out in one
+// pass, which keeps every operation amortized O(1). All memory is allocated in the constructor.
+template<typename Key, typename Value, typename Eviction = fifo_eviction,
+        typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class RingCache {
+private:
+    struct Slot {
+        Key key;
+        Value value;
+        size_t hash;
+        bool referenced;
+        bool live;
+    };
+
+    static constexpr uint32_t empty_ = UINT32_MAX;
+
+    size_t capacity_;
+    size_t mask_;
+    size_t size_ = 0;
+    // Sequence number of ring_.front(); the entry with sequence number s is ring_[s - front_seq_].
+    uint32_t front_seq_ = 0;
+    StaticBuffer<Slot, std::allocator<Slot>, unchecked_policy> ring_;
+    std::unique_ptr<uint32_t[]> index_;
+    Hash hash_;
+    KeyEqual equal_;
+
+    static size_t checked_capacity(size_t c) {
+        if (c == 0 || c >= empty_ / 16) throw std::out_of_range("invalid cache capacity");
+        return c;
+    }
+
+    size_t hash_of(const Key &key) const {
+        uint64_t h = hash_(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    Slot &slot_at(uint32_t seq) {
+        return ring_[static_cast<uint32_t>(seq - front_seq_)];
+    }
+
+    const Slot &slot_at(uint32_t seq) const {
+        return ring_[static_cast<uint32_t>(seq - front_seq_)];
+    }
+
+    size_t find_position(const Key &key, size_t h) const {
+        for (size_t pos = h & mask_;; pos = (pos + 1) & mask_) {
+            uint32_t seq = index_[pos];
+            if (seq == empty_) return pos;
+            const Slot &slot = slot_at(seq);
+            if (slot.hash == h && equal_(slot.key, key)) return pos;
+        }
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones.
+    void remove_position(size_t pos) {
+        for (size_t next = (pos + 1) & mask_; index_[next] != empty_; next = (next + 1) & mask_) {
+            size_t ideal = slot_at(index_[next]).hash & mask_;
+            if (((next - ideal) & mask_) >= ((next - pos) & mask_)) {
+                index_[pos] = index_[next];
+                pos = next;
+            }
+        }
+        index_[pos] = empty_;
+    }
+
+    // Drops dead slots while keeping the order and renumbers the live ones from zero.
+    void compact() {
+        for (size_t n = ring_.size(); n > 0; --n) {
+            Slot slot = std::move(ring_.front());
+            ring_.pop_front();
+            if (slot.live) ring_.push_back(std::move(slot));
+        }
+        front_seq_ = 0;
+        std::fill(index_.get(), index_.get() + mask_ + 1, empty_);
+        for (uint32_t seq = 0; seq < ring_.size(); ++seq) {
+            index_[find_position(ring_[seq].key, ring_[seq].hash)] = seq;
+        }
+    }
+
+    // Appends a slot at the back of the ring and returns its sequence number.
+    uint32_t append(Slot &&slot) {
+        uint32_t seq = front_seq_ + static_cast<uint32_t>(ring_.size());
+        ring_.push_back(std::move(slot));
+        return seq;
+    }
+
+    void pop_front() {
+        ring_.pop_front();
+        ++front_seq_;
+    }
+
+    void evict() {
+        while (true) {
+            Slot &slot = ring_.front();
+            if (!slot.live) {
+                pop_front();
+                continue;
+            }
+            if constexpr (Eviction::second_chance) {
+                if (slot.referenced) {
+                    size_t pos = find_position(slot.key, slot.hash);
+                    Slot moved = std::move(slot);
+                    moved.referenced = false;
+                    pop_front();
+                    index_[pos] = append(std::move(moved));
+                    continue;
+                }
+            }
+            remove_position(find_position(slot.key, slot.hash));
+            pop_front();
+            --size_;
+            return;
+        }
+    }
+
+public:
+    explicit RingCache(size_t c, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+            : capacity_(checked_capacity(c)), ring_(2 * capacity_), hash_(hash), equal_(equal) {
+        size_t table = 1;
+        while (table < 2 * c) table *= 2;
+        mask_ = table - 1;
+        index_.reset(new uint32_t[table]);
+        std::fill(index_.get(), index_.get() + table, empty_);
+    }
+
+    RingCache(const RingCache &other) = delete;
+
+    RingCache &operator=(const RingCache &other) = delete;
+
+    Value *get(const Key &key) {
+        uint32_t seq = index_[find_position(key, hash_of(key))];
+        if (seq == empty_) return nullptr;
+        Slot &slot = slot_at(seq);
+        slot.referenced = true;
+        return &slot.value;
+    }
+
+    [[nodiscard]] bool contains(const Key &key) const {
+        return index_[find_position(key, hash_of(key))] != empty_;
+    }
+
+    void put(const Key &key, const Value &value) {
+        size_t h = hash_of(key);
+        size_t pos = find_position(key, h);
+        if (index_[pos] != empty_) {
+            Slot &slot = slot_at(index_[pos]);
+            slot.value = value;
+            slot.referenced = true;
+            return;
+        }
+        // Compacting here, before evict, keeps sequence numbers far from wrapping and
+        // guarantees room for the slots evict moves to the back.
+        if (ring_.size() == ring_.capacity() || front_seq_ > empty_ / 2) compact();
+        if (size_ == capacity_) evict();
+        uint32_t seq = append(Slot{key, value, h, false, true});
+        index_[find_position(key, h)] = seq;
+        ++size_;
+    }
+
+    bool erase(const Key &key) {
+        size_t pos = find_position(key, hash_of(key));
+        uint32_t seq = index_[pos];
+        if (seq == empty_) return false;
+        slot_at(seq).live = false;
+        remove_position(pos);
+        --size_;
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+};
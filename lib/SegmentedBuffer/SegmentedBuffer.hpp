@@ -0,0 +1,221 @@
+#pragma once
+
+#include "../DynamicBuffer/DynamicBuffer.hpp"
+#include "../IndexIterator/IndexIterator.hpp"
+#include <span>
+#include <utility>
+
+template<typename T>
+constexpr size_t default_block_size() {
+    return sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+}
+
+// Ring of fixed-size blocks addressed through a circular block map. Growth only adds blocks,
+// so elements never move and references stay valid across push/pop at either end.
+template<typename T, size_t BlockSize = default_block_size<T>(), typename Alloc = std::allocator<T>>
+class SegmentedBuffer {
+    static_assert(BlockSize > 0, "block size must be positive");
+
+private:
+    using allocator_traits = std::allocator_traits<Alloc>;
+    using map_allocator = typename allocator_traits::template rebind_alloc<T *>;
+
+    Alloc alloc;
+    DynamicBuffer<T *, map_allocator> map_;
+    T *spare_ = nullptr;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    T *block(size_t k) const {
+        auto first = map_.first_segment();
+        return k < first.size() ? first[k] : map_.second_segment()[k - first.size()];
+    }
+
+    T *element(size_t i) const {
+        size_t pos = head_ + i;
+        return block(pos / BlockSize) + pos % BlockSize;
+    }
+
+    // One emptied block is kept aside so pushing and popping across a block boundary does not
+    // allocate every time.
+    T *allocate_block() {
+        if (spare_ != nullptr) return std::exchange(spare_, nullptr);
+        return allocator_traits::allocate(alloc, BlockSize);
+    }
+
+    void release_block(T *b) {
+        if (spare_ == nullptr) spare_ = b;
+        else allocator_traits::deallocate(alloc, b, BlockSize);
+    }
+
+    void release_all() {
+        clear();
+        while (!map_.empty()) {
+            allocator_traits::deallocate(alloc, block(map_.size() - 1), BlockSize);
+            map_.pop_back();
+        }
+        if (spare_ != nullptr) allocator_traits::deallocate(alloc, std::exchange(spare_, nullptr), BlockSize);
+    }
+
+public:
+    using value_type = T;
+    using iterator = IndexIterator<SegmentedBuffer, false>;
+    using const_iterator = IndexIterator<SegmentedBuffer, true>;
+
+    SegmentedBuffer() = default;
+
+    SegmentedBuffer(const SegmentedBuffer &other)
+            : alloc(allocator_traits::select_on_container_copy_construction(other.alloc)) {
+        try {
+            for (size_t k = 0; k < other.block_count(); ++k) {
+                for (const T &x: other.segment(k)) {
+                    push_back(x);
+                }
+            }
+        }
+        catch (...) {
+            release_all();
+            throw;
+        }
+    }
+
+    SegmentedBuffer &operator=(const SegmentedBuffer &other) {
+        if (this == &other) return *this;
+        SegmentedBuffer temp(other);
+        swap(temp);
+        return *this;
+    }
+
+    ~SegmentedBuffer() {
+        release_all();
+    }
+
+    void swap(SegmentedBuffer &other) {
+        std::swap(alloc, other.alloc);
+        map_.swap(other.map_);
+        std::swap(spare_, other.spare_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    void push_back(const T &element) {
+        if (head_ + size_ == map_.size() * BlockSize) {
+            T *b = allocate_block();
+            try {
+                map_.push_back(b);
+            }
+            catch (...) {
+                release_block(b);
+                throw;
+            }
+        }
+        std::construct_at(this->element(size_), element);
+        ++size_;
+    }
+
+    void push_front(const T &element) {
+        if (head_ == 0) {
+            T *b = allocate_block();
+            try {
+                map_.push_front(b);
+            }
+            catch (...) {
+                release_block(b);
+                throw;
+            }
+            head_ = BlockSize;
+        }
+        size_t pos = head_ - 1;
+        std::construct_at(block(pos / BlockSize) + pos % BlockSize, element);
+        head_ = pos;
+        ++size_;
+    }
+
+    void pop_front() {
+        if (empty()) return;
+        std::destroy_at(element(0));
+        ++head_;
+        --size_;
+        if (head_ == BlockSize) {
+            release_block(map_.front());
+            map_.pop_front();
+            head_ = 0;
+        }
+    }
+
+    void pop_back() {
+        if (empty()) return;
+        --size_;
+        std::destroy_at(element(size_));
+        if (head_ + size_ <= (map_.size() - 1) * BlockSize) {
+            release_block(block(map_.size() - 1));
+            map_.pop_back();
+        }
+    }
+
+    void clear() {
+        while (!empty()) {
+            pop_back();
+        }
+    }
+
+    T &operator[](size_t i) {
+        return *element(i);
+    }
+
+    const T &operator[](size_t i) const {
+        return *element(i);
+    }
+
+    T &at(size_t i) {
+        if (i >= size_) throw std::out_of_range("Out of range in buffer");
+        return *element(i);
+    }
+
+    T &front() {
+        return *element(0);
+    }
+
+    T &back() {
+        return *element(size_ - 1);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] size_t block_count() const {
+        return map_.size();
+    }
+
+    // Live elements of the k-th block; every segment is contiguous.
+    std::span<T> segment(size_t k) {
+        size_t first = k == 0 ? head_ : 0;
+        size_t last = std::min(BlockSize, head_ + size_ - std::min(head_ + size_, k * BlockSize));
+        return {block(k) + first, block(k) + std::max(first, last)};
+    }
+
+    [[nodiscard]] std::span<const T> segment(size_t k) const {
+        return const_cast<SegmentedBuffer *>(this)->segment(k);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, size_);
+    }
+
+    [[nodiscard]] const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+
+    [[nodiscard]] const_iterator cend() const {
+        return const_iterator(this, size_);
+    }
+};
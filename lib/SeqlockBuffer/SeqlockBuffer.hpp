@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <span>
+#include <type_traits>
+
+// Fixed-size ring for one writer and any number of lock-free readers.
+// The writer overwrites the oldest entry; every slot carries a sequence number
+// (odd while it is being written) so readers can detect torn or overwritten copies.
+template<typename T>
+class SeqlockBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockBuffer requires a trivially copyable type");
+
+private:
+    // The payload is kept as relaxed atomic words, so the writer and a racing reader never
+    // touch the same non-atomic memory; the sequence number decides whether a copy is usable.
+    static constexpr size_t words_ = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<uint64_t> words[words_]{};
+    };
+
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+
+    static uint64_t published(uint64_t index) {
+        return 2 * index + 2;
+    }
+
+public:
+    explicit SeqlockBuffer(size_t c) : capacity_(c) {
+        if (c == 0) throw std::out_of_range("zero capacity");
+        slots_.reset(new Slot[c]);
+    }
+
+    SeqlockBuffer(const SeqlockBuffer &other) = delete;
+
+    SeqlockBuffer &operator=(const SeqlockBuffer &other) = delete;
+
+    // Writer side: two stores to the slot sequence and one to the head.
+    void push_back(const T &element) {
+        uint64_t index = head_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[index % capacity_];
+        slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        uint64_t words[words_]{};
+        std::memcpy(words, &element, sizeof(T));
+        for (size_t w = 0; w < words_; ++w) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        slot.seq.store(published(index), std::memory_order_release);
+        head_.store(index + 1, std::memory_order_release);
+    }
+
+    // Copies up to out.size() newest entries into the front of out, oldest first, and
+    // returns how many were copied. Entries overwritten while being read are dropped,
+    // so the result is always a consistent run ending at the newest entry seen.
+    // Nothing is allocated: the reader works only in the caller's storage.
+    size_t read_latest(std::span<T> out) const {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        size_t n = std::min<uint64_t>({out.size(), head, capacity_});
+        size_t first = 0;
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t index = head - n + i;
+            const Slot &slot = slots_[index % capacity_];
+            uint64_t before = slot.seq.load(std::memory_order_acquire);
+            uint64_t words[words_];
+            for (size_t w = 0; w < words_; ++w) {
+                words[w] = slot.words[w].load(std::memory_order_relaxed);
+            }
+            std::memcpy(&out[i], words, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t after = slot.seq.load(std::memory_order_relaxed);
+            if (before != published(index) || after != before) first = i + 1;
+        }
+        if (first != 0) std::memmove(out.data(), out.data() + first, (n - first) * sizeof(T));
+        return n - first;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return std::min<uint64_t>(head_.load(std::memory_order_acquire), capacity_);
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return head_.load(std::memory_order_acquire) == 0;
+    }
+};
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Single-producer/single-consumer ring in shared memory (POSIX shm or memfd).
+// Both sides validate the header before use; an optional futex doorbell lets an idle
+// consumer sleep instead of spinning.
+class SharedRingBase {
+protected:
+    static constexpr uint64_t magic_ = 0x474e4952454c4359ULL;
+    static constexpr uint32_t version_ = 1;
+
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t element_size;
+        uint64_t capacity;
+        uint32_t doorbell_enabled;
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<uint32_t> doorbell;
+        std::atomic<uint32_t> waiting;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+
+    static constexpr size_t data_offset_ = (sizeof(Header) + 63) / 64 * 64;
+
+    int fd_ = -1;
+    void *mapping_ = nullptr;
+    size_t length_ = 0;
+    Header *header_ = nullptr;
+    unsigned char *data_ = nullptr;
+
+    static void throw_errno(const char *what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    SharedRingBase() = default;
+
+    void map(int fd, size_t length) {
+        fd_ = fd;
+        length_ = length;
+        mapping_ = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw_errno("mmap");
+        }
+        header_ = static_cast<Header *>(mapping_);
+        data_ = static_cast<unsigned char *>(mapping_) + data_offset_;
+    }
+
+    // An empty name creates an anonymous memfd, shared with children through fork.
+    void create(const std::string &name, uint32_t element_size, uint64_t capacity, bool doorbell) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::out_of_range("capacity must be a power of two");
+        }
+        int fd = name.empty() ? memfd_create("cycle_ring", 0) : shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw_errno(name.empty() ? "memfd_create" : "shm_open");
+        size_t length = data_offset_ + capacity * element_size;
+        if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            int error = errno;
+            close(fd);
+            if (!name.empty()) shm_unlink(name.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+        try {
+            map(fd, length);
+        }
+        catch (...) {
+            if (!name.empty()) shm_unlink(name.c_str());
+            throw;
+        }
+        header_ = new(mapping_) Header{magic_, version_, element_size, capacity, doorbell, {0}, {0}, {0}, {0}};
+    }
+
+    void open(const std::string &name, uint32_t element_size) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) throw_errno("shm_open");
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < data_offset_) {
+            close(fd);
+            throw std::runtime_error("shared ring is too small");
+        }
+        map(fd, st.st_size);
+        if (header_->magic != magic_ || header_->version != version_) {
+            throw std::runtime_error("shared ring header mismatch");
+        }
+        uint64_t capacity = header_->capacity;
+        if (header_->element_size != element_size || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+            capacity > (length_ - data_offset_) / element_size) {
+            throw std::runtime_error("shared ring layout mismatch");
+        }
+    }
+
+    void notify() {
+        if (!header_->doorbell_enabled) return;
+        header_->doorbell.fetch_add(1, std::memory_order_seq_cst);
+        if (header_->waiting.load(std::memory_order_seq_cst) != 0) {
+            syscall(SYS_futex, &header_->doorbell, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+        }
+    }
+
+    // Sleeps until the producer moves head past tail. Without the doorbell this spins.
+    void wait(uint64_t tail) {
+        while (header_->head.load(std::memory_order_acquire) == tail) {
+            if (!header_->doorbell_enabled) continue;
+            uint32_t bell = header_->doorbell.load(std::memory_order_seq_cst);
+            if (header_->head.load(std::memory_order_acquire) != tail) return;
+            header_->waiting.fetch_add(1, std::memory_order_seq_cst);
+            syscall(SYS_futex, &header_->doorbell, FUTEX_WAIT, bell, nullptr, nullptr, 0);
+            header_->waiting.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+public:
+    SharedRingBase(const SharedRingBase &other) = delete;
+
+    SharedRingBase &operator=(const SharedRingBase &other) = delete;
+
+    SharedRingBase(SharedRingBase &&other) noexcept
+            : fd_(std::exchange(other.fd_, -1)), mapping_(std::exchange(other.mapping_, nullptr)),
+              length_(other.length_), header_(other.header_), data_(other.data_) {}
+
+    ~SharedRingBase() {
+        if (mapping_ != nullptr) munmap(mapping_, length_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    static void unlink(const std::string &name) {
+        shm_unlink(name.c_str());
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return header_->capacity;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return header_->head.load(std::memory_order_acquire) - header_->tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+};
+
+template<typename T>
+class SharedRing : public SharedRingBase {
+    static_assert(std::is_trivially_copyable_v<T>, "SharedRing requires a trivially copyable type");
+
+private:
+    T *slot(uint64_t index) {
+        return reinterpret_cast<T *>(data_) + (index & (header_->capacity - 1));
+    }
+
+public:
+    static SharedRing create(const std::string &name, size_t capacity, bool doorbell = true) {
+        SharedRing ring;
+        ring.SharedRingBase::create(name, sizeof(T), capacity, doorbell);
+        return ring;
+    }
+
+    static SharedRing open(const std::string &name) {
+        SharedRing ring;
+        ring.SharedRingBase::open(name, sizeof(T));
+        return ring;
+    }
+
+    bool try_push(const T &element) {
+        uint64_t head = header_->head.load(std::memory_order_relaxed);
+        if (head - header_->tail.load(std::memory_order_acquire) == header_->capacity) return false;
+        std::memcpy(slot(head), &element, sizeof(T));
+        header_->head.store(head + 1, std::memory_order_release);
+        notify();
+        return true;
+    }
+
+    bool try_pop(T &element) {
+        uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        if (header_->head.load(std::memory_order_acquire) == tail) return false;
+        std::memcpy(&element, slot(tail), sizeof(T));
+        header_->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    T pop() {
+        T element;
+        while (!try_pop(element)) {
+            wait(header_->tail.load(std::memory_order_relaxed));
+        }
+        return element;
+    }
+};
+
+// Variable-length byte records: an 8-byte length prefix followed by the payload, padded to 8 bytes.
+// A record never straddles the end of the ring; the producer leaves a wrap marker instead.
+class SharedRecordRing : public SharedRingBase {
+private:
+    static constexpr uint64_t wrap_marker_ = UINT64_MAX;
+
+    static uint64_t padded(uint64_t length) {
+        return (length + 7) / 8 * 8;
+    }
+
+public:
+    static SharedRecordRing create(const std::string &name, size_t capacity_bytes, bool doorbell = true) {
+        if (capacity_bytes < 16) throw std::out_of_range("capacity is too small");
+        SharedRecordRing ring;
+        ring.SharedRingBase::create(name, 1, capacity_bytes, doorbell);
+        return ring;
+    }
+
+    static SharedRecordRing open(const std::string &name) {
+        SharedRecordRing ring;
+        ring.SharedRingBase::open(name, 1);
+        return ring;
+    }
+
+    [[nodiscard]] size_t max_record_size() const {
+        return header_->capacity / 2 - 8;
+    }
+
+    bool try_push(const void *record, size_t length) {
+        if (length > max_record_size()) throw std::out_of_range("record is too large");
+        uint64_t capacity = header_->capacity;
+        uint64_t head = header_->head.load(std::memory_order_relaxed);
+        uint64_t pos = head & (capacity - 1);
+        uint64_t need = 8 + padded(length);
+        uint64_t skip = capacity - pos < need ? capacity - pos : 0;
+        if (capacity - (head - header_->tail.load(std::memory_order_acquire)) < skip + need) return false;
+        if (skip != 0) {
+            std::memcpy(data_ + pos, &wrap_marker_, 8);
+            pos = 0;
+        }
+        uint64_t prefix = length;
+        std::memcpy(data_ + pos, &prefix, 8);
+        std::memcpy(data_ + pos + 8, record, length);
+        header_->head.store(head + skip + need, std::memory_order_release);
+        notify();
+        return true;
+    }
+
+    bool try_push(std::span<const char> record) {
+        return try_push(record.data(), record.size());
+    }
+
+    // The prefix comes from the other process, so it is checked against the ring bounds and
+    // the bytes actually published before anything is copied.
+    bool try_pop(std::vector<char> &record) {
+        uint64_t capacity = header_->capacity;
+        uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        uint64_t available = header_->head.load(std::memory_order_acquire) - tail;
+        if (available == 0) return false;
+        if (available > capacity) throw std::runtime_error("corrupt shared ring indices");
+        uint64_t pos = tail & (capacity - 1);
+        uint64_t skip = 0;
+        uint64_t length;
+        std::memcpy(&length, data_ + pos, 8);
+        if (length == wrap_marker_) {
+            skip = capacity - pos;
+            pos = 0;
+            if (available < skip + 8) throw std::runtime_error("corrupt shared ring record");
+            std::memcpy(&length, data_, 8);
+        }
+        if (length > max_record_size() || available < skip + 8 + padded(length) ||
+            pos + 8 + padded(length) > capacity) {
+            throw std::runtime_error("corrupt shared ring record");
+        }
+        record.assign(data_ + pos + 8, data_ + pos + 8 + length);
+        header_->tail.store(tail + skip + 8 + padded(length), std::memory_order_release);
+        return true;
+    }
+
+    std::vector<char> pop() {
+        std::vector<char> record;
+        while (!try_pop(record)) {
+            wait(header_->tail.load(std::memory_order_relaxed));
+        }
+        return record;
+    }
+};
@@ -1,25 +1,29 @@
+#pragma once
+
 #include "../CycleBuffer/CycleBuffer.hpp"
 
 
-template<typename T, typename Alloc = std::allocator<T>>
-class StaticBuffer : public CycleBuffer<T, Alloc> {
+template<typename T, typename Alloc = std::allocator<T>, typename Checking = default_checking_policy>
+class StaticBuffer : public CycleBuffer<T, Alloc, Checking> {
 private:
-    using CycleBuffer<T, Alloc>::capacity_;
-    using CycleBuffer<T, Alloc>::objects_;
-    using CycleBuffer<T, Alloc>::begin_;
-    using CycleBuffer<T, Alloc>::end_;
+    using CycleBuffer<T, Alloc, Checking>::capacity_;
+    using CycleBuffer<T, Alloc, Checking>::objects_;
+    using CycleBuffer<T, Alloc, Checking>::begin_;
+    using CycleBuffer<T, Alloc, Checking>::end_;
 public:
-    StaticBuffer() : CycleBuffer<T, Alloc>() {};
+    using iterator = typename CycleBuffer<T, Alloc, Checking>::iterator;
+
+    constexpr StaticBuffer() : CycleBuffer<T, Alloc, Checking>() {};
 
-    explicit StaticBuffer(size_t c, const T &element) : CycleBuffer<T, Alloc>(c, element) {};
+    constexpr explicit StaticBuffer(size_t c, const T &element) : CycleBuffer<T, Alloc, Checking>(c, element) {};
 
-    explicit StaticBuffer(size_t c) : CycleBuffer<T, Alloc>(c) {};
+    constexpr explicit StaticBuffer(size_t c) : CycleBuffer<T, Alloc, Checking>(c) {};
 
-    explicit StaticBuffer(const CycleBuffer<T, Alloc> &other) : CycleBuffer<T, Alloc>(other) {};
+    constexpr explicit StaticBuffer(const CycleBuffer<T, Alloc, Checking> &other) : CycleBuffer<T, Alloc, Checking>(other) {};
 
     StaticBuffer &operator=(const StaticBuffer &other) = delete;
 
-    void push_back(const T &element) {
+    constexpr void push_back(const T &element) {
         if (this->size() == this->capacity()) {
             throw std::out_of_range("out of container");
         }
@@ -28,20 +32,29 @@ public:
         if (++end_ == objects_ + capacity_) end_ = objects_;
     }
 
-    void pop_back() {
+    constexpr void push_back(T &&element) {
+        if (this->size() == this->capacity()) {
+            throw std::out_of_range("out of container");
+        }
+        std::construct_at(end_, std::move(element));
+
+        if (++end_ == objects_ + capacity_) end_ = objects_;
+    }
+
+    constexpr void pop_back() {
         if (this->empty()) return;
         if (end_ == objects_) end_ = objects_ + capacity_;
         std::destroy_at(--end_);
     }
 
-    void pop_front() {
+    constexpr void pop_front() {
         if (this->empty()) return;
         std::destroy_at(begin_);
         if (begin_ == objects_ + capacity_ - 1) begin_ = objects_;
         else ++begin_;
     }
 
-    void push_front(const T &element) {
+    constexpr void push_front(const T &element) {
         if (this->size() == this->capacity()) {
             throw std::out_of_range("out of container");
         }
@@ -50,14 +63,14 @@ public:
         std::construct_at(begin_, element);
     }
 
-    void clear() {
+    constexpr void clear() {
         while (!this->empty()) {
             this->pop_back();
         }
         begin_ = end_ = objects_;
     }
 
-    void erase(typename CycleBuffer<T, Alloc>::iterator q1, typename CycleBuffer<T, Alloc>::iterator q2) {
+    constexpr void erase(iterator q1, iterator q2) {
         auto diff = q2 - q1;
         while (q2 != this->end()) {
             (*q1) = *q2;
@@ -70,12 +83,12 @@ public:
         }
     }
 
-    void erase(typename CycleBuffer<T, Alloc>::iterator q) {
+    constexpr void erase(iterator q) {
         return this->erase(q, q + 1);
     }
 
     template<typename InputIt>
-    void assign(InputIt f, InputIt l) {
+    constexpr void assign(InputIt f, InputIt l) {
         this->clear();
         while (f != l) {
             this->push_back(*f);
@@ -83,11 +96,11 @@ public:
         }
     }
 
-    void assign(std::initializer_list<T> l) {
+    constexpr void assign(std::initializer_list<T> l) {
         this->assign(l.begin(), l.end());
     }
 
-    void assign(size_t n, const T &element) {
+    constexpr void assign(size_t n, const T &element) {
         this->clear();
         while (n > 0) {
             this->push_back(element);
@@ -95,7 +108,7 @@ public:
         }
     }
 
-    typename CycleBuffer<T, Alloc>::iterator insert(typename CycleBuffer<T, Alloc>::iterator p, const T &element) {
+    constexpr iterator insert(iterator p, const T &element) {
         auto index = p - this->begin();
         this->push_back(element);
         p = this->begin() + index;
@@ -109,8 +122,7 @@ public:
         return this->begin() + index;
     }
 
-    typename CycleBuffer<T, Alloc>::iterator
-    insert(typename CycleBuffer<T, Alloc>::iterator p, size_t n, const T &element) {
+    constexpr iterator insert(iterator p, size_t n, const T &element) {
         auto index = p - this->begin();
         for (int i = 0; i < n; i++) {
             this->push_back(element);
@@ -125,8 +137,7 @@ public:
         return it;
     }
 
-    typename CycleBuffer<T, Alloc>::iterator
-    insert(typename CycleBuffer<T, Alloc>::iterator p, const std::initializer_list<T> &l) {
+    constexpr iterator insert(iterator p, const std::initializer_list<T> &l) {
         auto index = p - this->begin();
         for (int i = 0; i < l.size(); i++) {
             this->push_back(*l.begin());
@@ -147,7 +158,7 @@ public:
     }
 
     template<typename InputIt>
-    typename CycleBuffer<T, Alloc>::iterator insert(typename CycleBuffer<T, Alloc>::iterator p, InputIt f, InputIt l) {
+    constexpr iterator insert(iterator p, InputIt f, InputIt l) {
         auto it = p;
         auto index = p - this->begin();
         while (f != l) {
@@ -156,4 +167,7 @@ public:
         }
         return this->begin() + index;
     }
-};
\ No newline at end of file
+};
+
+template<typename T, typename Alloc, typename Checking>
+struct std::hash<StaticBuffer<T, Alloc, Checking>> : std::hash<CycleBuffer<T, Alloc, Checking>> {};
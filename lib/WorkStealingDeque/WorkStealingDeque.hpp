@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Chase-Lev work-stealing deque. The owner thread calls push/pop at the bottom,
+// any thread may steal from the top. Growing replaces the circular array without blocking
+// thieves; replaced arrays are kept until the deque is destroyed, since a thief may
+// still be reading from one.
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable type");
+
+private:
+    struct Array {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T>[]> data;
+
+        explicit Array(int64_t c) : capacity(c), data(new std::atomic<T>[c]) {}
+
+        T get(int64_t i) const {
+            return data[i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, T x) {
+            data[i & (capacity - 1)].store(x, std::memory_order_relaxed);
+        }
+
+        Array *grow(int64_t bottom, int64_t top) const {
+            auto *bigger = new Array(capacity * 2);
+            for (int64_t i = top; i < bottom; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Array *> array_;
+    std::vector<std::unique_ptr<Array>> retired_;
+
+public:
+    explicit WorkStealingDeque(size_t c = 64) {
+        int64_t capacity = 1;
+        while (capacity < static_cast<int64_t>(c)) capacity *= 2;
+        array_.store(new Array(capacity), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &other) = delete;
+
+    WorkStealingDeque &operator=(const WorkStealingDeque &other) = delete;
+
+    ~WorkStealingDeque() {
+        delete array_.load(std::memory_order_relaxed);
+    }
+
+    // Owner only.
+    void push(T x) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Array *a = array_.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            Array *bigger = a->grow(b, t);
+            retired_.emplace_back(a);
+            array_.store(bigger, std::memory_order_release);
+            a = bigger;
+        }
+        a->put(b, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only: takes the most recently pushed element.
+    std::optional<T> pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array *a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T x = a->get(b);
+        if (t == b) {
+            bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) return std::nullopt;
+        }
+        return x;
+    }
+
+    // Any thread: takes the oldest element, or nothing if empty or another thread won the race.
+    std::optional<T> steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return std::nullopt;
+        Array *a = array_.load(std::memory_order_acquire);
+        T x = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return x;
+    }
+
+    [[nodiscard]] size_t size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+
+    [[nodiscard]] size_t capacity() const {
+        return array_.load(std::memory_order_relaxed)->capacity;
+    }
+};
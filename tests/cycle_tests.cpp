@@ -1,6 +1,19 @@
 #include "./lib/DynamicBuffer/DynamicBuffer.hpp"
 #include "./lib/StaticBuffer/StaticBuffer.hpp"
+#include "./lib/Algorithms/SegmentedAlgorithms.hpp"
+#include "./lib/SeqlockBuffer/SeqlockBuffer.hpp"
+#include "./lib/CompressedBuffer/CompressedBuffer.hpp"
+#include "./lib/RingCache/RingCache.hpp"
+#include "./lib/SegmentedBuffer/SegmentedBuffer.hpp"
+#include "./lib/BipBuffer/BipBuffer.hpp"
+#include "./lib/CompactBuffer/CompactBuffer.hpp"
+#include "./lib/WorkStealingDeque/WorkStealingDeque.hpp"
+#include "./lib/FixedBuffer/FixedBuffer.hpp"
 #include <gtest/gtest.h>
+#include <deque>
+#include <random>
+#include <thread>
+#include <unordered_map>
 
 TEST(DynamicBufferTests, ConstructorTest1){
     DynamicBuffer<int> buf(3, 5);
@@ -342,7 +355,921 @@ TEST(StaticBufferTests, SortTest) {
     ASSERT_TRUE(ans == "0 1 2 8 9 10 ");
 }
 
+TEST(StaticBufferTests, MovePushBackTest) {
+    StaticBuffer<std::vector<int>> buf(2);
+    std::vector<int> values(100);
+    const int *data = values.data();
+    buf.push_back(std::move(values));
+    ASSERT_TRUE(buf.front().data() == data);
+}
+
+TEST(DynamicBufferTests, MovePushBackTest) {
+    DynamicBuffer<std::vector<int>> buf(1);
+    std::vector<int> first(10);
+    std::vector<int> second(20);
+    const int *data = second.data();
+    buf.push_back(std::move(first));
+    buf.push_back(std::move(second));
+    ASSERT_TRUE(buf.size() == 2 && buf.back().data() == data);
+    buf.push_back(std::move(buf.front()));
+    ASSERT_TRUE(buf.size() == 3 && buf.back().size() == 10);
+}
+
+
+
+
+
+
+
+TEST(SegmentedTests, LinearizeTest) {
+    StaticBuffer<std::string> buf(5);
+    for (int i = 0; i < 5; i++) {
+        buf.push_back(std::to_string(i));
+    }
+    buf.pop_front();
+    buf.pop_front();
+    buf.push_back("5");
+    buf.push_back("6");
+    ASSERT_FALSE(buf.second_segment().empty());
+    std::string *first = buf.linearize();
+    std::string ans;
+    for (size_t i = 0; i < buf.size(); i++) {
+        ans += first[i] + " ";
+    }
+    ASSERT_TRUE(buf.is_linearized() && buf.second_segment().empty());
+    ASSERT_TRUE(ans == "2 3 4 5 6 ");
+}
+
+TEST(SegmentedTests, SortTest) {
+    StaticBuffer<int> buf(6);
+    for (int i = 0; i < 6; i++) {
+        buf.push_back(10 - i);
+    }
+    buf.pop_front();
+    buf.pop_front();
+    buf.push_back(0);
+    buf.push_back(20);
+    segmented::sort(std::execution::par, buf);
+    ASSERT_TRUE(std::binary_search(buf.linearize(), buf.linearize() + buf.size(), 7));
+    std::string ans;
+    for (auto i: buf) {
+        ans += std::to_string(i) + " ";
+    }
+    ASSERT_TRUE(ans == "0 5 6 7 8 20 ");
+}
+
+TEST(SegmentedTests, ReduceTest) {
+    StaticBuffer<int> buf(4);
+    for (int i = 1; i <= 4; i++) {
+        buf.push_back(i);
+    }
+    buf.pop_front();
+    buf.push_back(5);
+    segmented::for_each(std::execution::par_unseq, buf, [](int &x) { x *= 2; });
+    ASSERT_TRUE(segmented::reduce(buf) == 28);
+    ASSERT_TRUE(segmented::reduce(std::execution::par, buf, 1, std::multiplies<>()) == 1920);
+}
+
+TEST(SegmentedTests, CopyFillTest) {
+    DynamicBuffer<int> buf;
+    for (int i = 0; i < 5; i++) {
+        buf.push_front(i);
+    }
+    std::vector<int> out(5);
+    segmented::copy(buf, out.begin());
+    ASSERT_TRUE(out == std::vector<int>({4, 3, 2, 1, 0}));
+    segmented::transform(std::execution::par, buf, out.begin(), [](int x) { return x + 1; });
+    ASSERT_TRUE(out == std::vector<int>({5, 4, 3, 2, 1}));
+    segmented::fill(buf, 7);
+    ASSERT_TRUE(segmented::reduce(buf) == 35);
+}
+
+TEST(CheckingPolicyTests, UncheckedTest) {
+    DynamicBuffer<int, std::allocator<int>, unchecked_policy> buf;
+    for (int i = 0; i < 3; i++) {
+        buf.push_front(i);
+        buf.push_back(10 - i);
+    }
+    ASSERT_TRUE(buf.begin() == buf.begin() + int(buf.capacity() + 1) * 8);
+    ASSERT_TRUE(buf.end() - 6 == buf.begin() && buf.begin() - 1 + 1 == buf.begin());
+    std::sort(buf.begin(), buf.end());
+    std::string ans;
+    for (auto i: buf) {
+        ans += std::to_string(i) + " ";
+    }
+    ASSERT_TRUE(ans == "0 1 2 8 9 10 ");
+}
+
+TEST(CheckingPolicyTests, CheckedTest) {
+    StaticBuffer<int, std::allocator<int>, checked_policy> buf(3);
+    buf.push_back(1);
+    ASSERT_THROW(*buf.end(), std::out_of_range);
+}
+
+TEST(CheckingPolicyTests, DefaultCheckedTest) {
+    static_assert(std::is_same_v<default_checking_policy, checked_policy>);
+    DynamicBuffer<int> buf;
+    buf.push_back(1);
+    ASSERT_THROW(*buf.end(), std::out_of_range);
+}
+
+TEST(CheckingPolicyTests, HardenedTest) {
+    DynamicBuffer<int, std::allocator<int>, hardened_policy> buf(2);
+    buf.push_back(1);
+    auto it = buf.begin();
+    ASSERT_TRUE(*it == 1);
+    buf.push_back(2);
+    buf.push_back(3);
+    ASSERT_THROW(*it, std::logic_error);
+    ASSERT_TRUE(*buf.begin() == 1);
+}
+
+TEST(CopyTests, CopyConstructorTest) {
+    DynamicBuffer<std::string> buf;
+    for (int i = 0; i < 5; i++) {
+        buf.push_front(std::to_string(i));
+    }
+    DynamicBuffer<std::string> copy(buf);
+    ASSERT_TRUE(copy.size() == 5 && copy.capacity() == buf.capacity());
+    ASSERT_TRUE(copy.front() == "4" && copy.back() == "0");
+}
+
+TEST(CopyTests, AssignReuseTest) {
+    DynamicBuffer<int> buf;
+    for (int i = 0; i < 5; i++) {
+        buf.push_front(i);
+    }
+    DynamicBuffer<int> other(20);
+    other.push_back(100);
+    other = buf;
+    ASSERT_TRUE(other.capacity() == 20);
+    std::string ans;
+    for (auto i: other) {
+        ans += std::to_string(i) + " ";
+    }
+    ASSERT_TRUE(ans == "4 3 2 1 0 ");
+    DynamicBuffer<int> small;
+    small = other;
+    ASSERT_TRUE(small.size() == 5 && small.front() == 4);
+}
+
+TEST(CopyTests, SnapshotTest) {
+    StaticBuffer<int> buf(4);
+    for (int i = 0; i < 4; i++) {
+        buf.push_back(i);
+    }
+    buf.pop_front();
+    buf.push_back(4);
+    auto snap = buf.snapshot();
+    buf.pop_front();
+    buf.push_back(5);
+    ASSERT_TRUE(snap.size() == 4 && snap[0] == 1 && snap[3] == 4);
+    auto shared = snap;
+    ASSERT_TRUE(shared.begin() == snap.begin());
+}
+
+TEST(CopyTests, SelfPushTest) {
+    DynamicBuffer<std::string> buf;
+    buf.push_back("a");
+    for (int i = 0; i < 6; i++) {
+        buf.push_back(buf.front());
+    }
+    ASSERT_TRUE(buf.size() == 7 && buf.back() == "a");
+}
+
+TEST(CopyTests, ZeroCapacityPushTest) {
+    DynamicBuffer<int> back(0);
+    back.push_back(1);
+    back.push_back(2);
+    DynamicBuffer<int> front(0);
+    front.push_front(1);
+    front.push_front(2);
+    ASSERT_TRUE(back.size() == 2 && back.front() == 1 && back.back() == 2);
+    ASSERT_TRUE(front.size() == 2 && front.front() == 2 && front.back() == 1);
+}
+
+TEST(SeqlockBufferTests, ReadLatestTest) {
+    SeqlockBuffer<int> buf(4);
+    std::vector<int> out(10);
+    ASSERT_TRUE(buf.read_latest(std::span<int>(out.data(), 3)) == 0);
+    for (int i = 0; i < 6; i++) {
+        buf.push_back(i);
+    }
+    ASSERT_TRUE(buf.read_latest(out) == 4);
+    ASSERT_TRUE(std::vector<int>(out.begin(), out.begin() + 4) == std::vector<int>({2, 3, 4, 5}));
+    std::array<int, 2> last{};
+    ASSERT_TRUE(buf.read_latest(last) == 2);
+    ASSERT_TRUE(last[0] == 4 && last[1] == 5);
+}
+
+TEST(SeqlockBufferTests, ConcurrentReadTest) {
+    struct Entry {
+        uint64_t value;
+        uint64_t check;
+    };
+    SeqlockBuffer<Entry> buf(64);
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&] {
+            std::array<Entry, 16> out{};
+            while (!done.load()) {
+                size_t n = buf.read_latest(out);
+                for (size_t i = 0; i < n; i++) {
+                    if (out[i].check != ~out[i].value || (i > 0 && out[i].value != out[i - 1].value + 1)) {
+                        consistent = false;
+                    }
+                }
+            }
+        });
+    }
+    for (uint64_t i = 0; i < 200000; i++) {
+        buf.push_back({i, ~i});
+    }
+    done = true;
+    for (auto &t: readers) {
+        t.join();
+    }
+    ASSERT_TRUE(consistent.load());
+}
+
+TEST(CompressedBufferTests, DoubleRoundTripTest) {
+    CompressedBuffer<double> buf(4, 16);
+    std::vector<CompressedBuffer<double>::Sample> expected;
+    for (int i = 0; i < 100; i++) {
+        int64_t ts = 1000 + i * 10 + (i % 7 == 0 ? 3 : 0);
+        double value = i % 5 == 0 ? -1.5 * i : 20.25 + (i % 3) * 0.1;
+        buf.push_back(ts, value);
+        expected.push_back({ts, value});
+    }
+    ASSERT_TRUE(buf.size() == 4 * 16 + 100 % 16 && buf.block_count() == 4);
+    std::vector<CompressedBuffer<double>::Sample> decoded(buf.begin(), buf.end());
+    ASSERT_TRUE(std::equal(decoded.begin(), decoded.end(), expected.end() - buf.size()));
+    ASSERT_TRUE(buf.recent(0) == expected.back());
+}
+
+TEST(CompressedBufferTests, IntegerRoundTripTest) {
+    CompressedBuffer<int64_t> buf(8, 32);
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 200; i++) {
+        int64_t value = i % 11 == 0 ? INT64_MIN + i : i * i - 5000;
+        buf.push_back(i, value);
+        expected.push_back(value);
+    }
+    std::vector<int64_t> decoded;
+    for (auto &sample: buf) {
+        decoded.push_back(sample.value);
+    }
+    ASSERT_TRUE(decoded == expected);
+}
+
+TEST(CompressedBufferTests, CompressionTest) {
+    CompressedBuffer<double> buf(64, 256);
+    for (int i = 0; i < 64 * 256; i++) {
+        buf.push_back(1700000000000 + i * 1000, 50.0 + (i / 100) * 0.5);
+    }
+    ASSERT_TRUE(buf.memory_usage() * 5 < buf.size() * sizeof(CompressedBuffer<double>::Sample));
+}
+
+TEST(CompressedBufferTests, IteratorCategoryTest) {
+    using It = CompressedBuffer<int64_t>::const_iterator;
+    static_assert(std::is_same_v<It::iterator_category, std::input_iterator_tag>);
+    static_assert(std::input_iterator<It>);
+}
+
+TEST(RingCacheTests, FifoTest) {
+    RingCache<int, std::string> cache(3);
+    for (int i = 0; i < 3; i++) {
+        cache.put(i, std::to_string(i));
+    }
+    ASSERT_TRUE(*cache.get(0) == "0");
+    cache.put(3, "3");
+    ASSERT_TRUE(cache.size() == 3 && cache.get(0) == nullptr);
+    ASSERT_TRUE(*cache.get(1) == "1" && *cache.get(3) == "3");
+}
+
+TEST(RingCacheTests, ClockTest) {
+    RingCache<int, int, clock_eviction> cache(3);
+    for (int i = 0; i < 3; i++) {
+        cache.put(i, i * 10);
+    }
+    cache.get(0);
+    cache.put(3, 30);
+    ASSERT_TRUE(cache.contains(0) && !cache.contains(1));
+    cache.put(4, 40);
+    ASSERT_TRUE(cache.contains(0) && !cache.contains(2) && *cache.get(4) == 40);
+}
+
+TEST(RingCacheTests, EraseTest) {
+    RingCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    ASSERT_TRUE(cache.erase(1) && !cache.erase(1));
+    cache.put(3, 3);
+    ASSERT_TRUE(cache.size() == 2 && cache.contains(2) && cache.contains(3));
+}
+
+TEST(RingCacheTests, EraseKeepsFifoOrderTest) {
+    RingCache<int, int> cache(3);
+    for (int i = 1; i <= 3; i++) {
+        cache.put(i, i);
+    }
+    cache.erase(1);
+    cache.put(4, 4);
+    cache.put(5, 5);
+    ASSERT_TRUE(cache.contains(4) && !cache.contains(2) && cache.contains(3) && cache.contains(5));
+    ASSERT_THROW((RingCache<int, int>(0)), std::out_of_range);
+}
+
+TEST(RingCacheTests, EraseModelTest) {
+    RingCache<int, int> cache(16);
+    std::unordered_map<int, int> model;
+    std::deque<int> order;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(gen() % 48);
+        if (gen() % 3 == 0) {
+            ASSERT_TRUE(cache.erase(key) == (model.erase(key) == 1));
+            order.erase(std::remove(order.begin(), order.end(), key), order.end());
+            continue;
+        }
+        if (model.count(key)) {
+            ASSERT_TRUE(cache.get(key) != nullptr && *cache.get(key) == model[key]);
+            continue;
+        }
+        ASSERT_TRUE(cache.get(key) == nullptr);
+        if (model.size() == 16) {
+            model.erase(order.front());
+            order.pop_front();
+        }
+        cache.put(key, i);
+        model[key] = i;
+        order.push_back(key);
+        ASSERT_TRUE(cache.size() == model.size());
+    }
+}
+
+TEST(RingCacheTests, ModelTest) {
+    RingCache<int, int> cache(64);
+    std::unordered_map<int, int> model;
+    std::deque<int> order;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(gen() % 200);
+        if (model.count(key)) {
+            ASSERT_TRUE(cache.get(key) != nullptr && *cache.get(key) == model[key]);
+            continue;
+        }
+        ASSERT_TRUE(cache.get(key) == nullptr);
+        if (model.size() == 64) {
+            model.erase(order.front());
+            order.pop_front();
+        }
+        cache.put(key, i);
+        model[key] = i;
+        order.push_back(key);
+    }
+}
+
+TEST(SegmentedBufferTests, StableReferencesTest) {
+    SegmentedBuffer<std::string, 4> buf;
+    buf.push_back("first");
+    std::string *first = &buf.front();
+    for (int i = 0; i < 100; i++) {
+        buf.push_back(std::to_string(i));
+        buf.push_front(std::to_string(-i));
+    }
+    ASSERT_TRUE(first == &buf[100] && *first == "first");
+    for (int i = 0; i < 100; i++) {
+        buf.pop_front();
+    }
+    ASSERT_TRUE(first == &buf.front() && buf.size() == 101);
+}
+
+TEST(SegmentedBufferTests, DequeModelTest) {
+    SegmentedBuffer<int, 8> buf;
+    std::deque<int> model;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 5000; i++) {
+        switch (gen() % 4) {
+            case 0:
+                buf.push_back(i);
+                model.push_back(i);
+                break;
+            case 1:
+                buf.push_front(i);
+                model.push_front(i);
+                break;
+            case 2:
+                buf.pop_back();
+                if (!model.empty()) model.pop_back();
+                break;
+            default:
+                buf.pop_front();
+                if (!model.empty()) model.pop_front();
+        }
+    }
+    ASSERT_TRUE(std::equal(buf.begin(), buf.end(), model.begin(), model.end()));
+    size_t total = 0;
+    for (size_t k = 0; k < buf.block_count(); k++) {
+        total += buf.segment(k).size();
+    }
+    ASSERT_TRUE(total == buf.size() && buf.block_count() <= buf.size() / 8 + 2);
+}
 
+inline int live_allocations = 0;
+
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        ++live_allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        --live_allocations;
+        std::allocator<T>().deallocate(p, n);
+    }
 
+    bool operator==(const CountingAllocator &) const = default;
+};
+
+struct ThrowingCopy {
+    static inline int copies_left = -1;
+    int value;
+
+    ThrowingCopy(int v) : value(v) {}
+
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+        if (copies_left == 0) throw std::runtime_error("copy failed");
+        --copies_left;
+    }
+};
+
+TEST(SegmentedBufferTests, CopyCleanupTest) {
+    {
+        SegmentedBuffer<ThrowingCopy, 4, CountingAllocator<ThrowingCopy>> buf;
+        for (int i = 0; i < 10; i++) {
+            buf.push_back(ThrowingCopy(i));
+        }
+        ASSERT_TRUE(live_allocations > 3);
+        int before = live_allocations;
+        ThrowingCopy::copies_left = 6;
+        ASSERT_THROW(auto copy(buf), std::runtime_error);
+        ThrowingCopy::copies_left = -1;
+        ASSERT_TRUE(live_allocations == before);
+    }
+    ASSERT_TRUE(live_allocations == 0);
+}
+
+TEST(SegmentedBufferTests, SortCopyTest) {
+    SegmentedBuffer<int, 3> buf;
+    for (int i = 0; i < 10; i++) {
+        buf.push_front(i);
+    }
+    SegmentedBuffer<int, 3> copy(buf);
+    std::sort(buf.begin(), buf.end());
+    ASSERT_TRUE(buf[0] == 0 && buf[9] == 9 && copy[0] == 9 && copy[9] == 0);
+    copy = buf;
+    ASSERT_TRUE(std::equal(copy.cbegin(), copy.cend(), buf.cbegin()));
+}
+
+TEST(BipBufferTests, GrantTest) {
+    BipBuffer<int> buf(10);
+    auto grant = buf.reserve_write(6);
+    ASSERT_TRUE(grant.size() == 6);
+    std::iota(grant.begin(), grant.end(), 0);
+    buf.commit(6);
+    buf.release(5);
+    grant = buf.reserve_write(5);
+    ASSERT_TRUE(grant.size() == 5 && grant.data() == buf.read_grant().data() - 5);
+    std::fill(grant.begin(), grant.end(), 7);
+    buf.commit(3);
+    ASSERT_TRUE(buf.size() == 4 && buf.read_grant().size() == 1 && buf.read_grant()[0] == 5);
+    ASSERT_TRUE(buf.reserve_write(5).size() == 2);
+    buf.commit(0);
+    buf.release(1);
+    ASSERT_TRUE(buf.read_grant().size() == 3 && buf.read_grant()[2] == 7);
+    ASSERT_THROW(buf.commit(1), std::out_of_range);
+}
 
+TEST(BipBufferTests, StreamTest) {
+    BipBuffer<char> buf(16);
+    std::string sent;
+    std::string received;
+    for (int i = 0; i < 200; i++) {
+        std::string record(1 + i % 9, static_cast<char>('a' + i % 26));
+        auto grant = buf.reserve_write(record.size());
+        if (grant.size() == record.size()) {
+            std::copy(record.begin(), record.end(), grant.begin());
+            buf.commit(record.size());
+            sent += record;
+        } else {
+            buf.commit(0);
+        }
+        auto readable = buf.read_grant();
+        size_t n = std::min<size_t>(readable.size(), 1 + i % 5);
+        received.append(readable.data(), n);
+        buf.release(n);
+    }
+    while (!buf.empty()) {
+        auto readable = buf.read_grant();
+        received.append(readable.data(), readable.size());
+        buf.release(readable.size());
+    }
+    ASSERT_TRUE(received == sent);
+}
+
+TEST(BipBufferTests, ReleaseDuringGrantTest) {
+    BipBuffer<int> buf(10);
+    auto grant = buf.reserve_write(3);
+    std::iota(grant.begin(), grant.end(), 1);
+    buf.commit(3);
+    grant = buf.reserve_write(2);
+    grant[0] = 4;
+    grant[1] = 5;
+    buf.release(3);
+    buf.commit(2);
+    ASSERT_TRUE(buf.size() == 2 && buf.read_grant().size() == 2 && buf.read_grant()[0] == 4);
+    buf.release(2);
+    ASSERT_TRUE(buf.empty() && buf.read_grant().empty());
+}
+
+TEST(BipBufferTests, InterleavedModelTest) {
+    BipBuffer<int> buf(16);
+    std::deque<int> model;
+    std::mt19937 gen(5);
+    int next = 0;
+    for (int i = 0; i < 20000; i++) {
+        auto grant = buf.reserve_write(gen() % 8);
+        for (size_t j = 0; j < grant.size(); j++) {
+            grant[j] = next + static_cast<int>(j);
+        }
+        if (gen() % 2 == 0) {
+            auto read = buf.read_grant();
+            size_t k = read.empty() ? 0 : gen() % (read.size() + 1);
+            for (size_t j = 0; j < k; j++) {
+                ASSERT_TRUE(read[j] == model.front());
+                model.pop_front();
+            }
+            buf.release(k);
+        }
+        size_t k = grant.empty() ? 0 : gen() % (grant.size() + 1);
+        buf.commit(k);
+        for (size_t j = 0; j < k; j++) {
+            model.push_back(next++);
+        }
+        ASSERT_TRUE(buf.size() == model.size());
+        ASSERT_TRUE(buf.read_grant().empty() == model.empty());
+        if (!model.empty()) {
+            ASSERT_TRUE(buf.read_grant()[0] == model.front());
+        }
+    }
+}
+
+TEST(SmallBufferTests, InlineTest) {
+    SmallDynamicBuffer<std::string, 8> buf;
+    ASSERT_TRUE(buf.empty() && buf.is_inline() && buf.capacity() == 8);
+    for (int i = 0; i < 8; i++) {
+        buf.push_back(std::to_string(i));
+    }
+    buf.pop_front();
+    buf.push_back("8");
+    ASSERT_TRUE(buf.is_inline() && buf.front() == "1" && buf.back() == "8");
+    buf.push_front("0");
+    ASSERT_FALSE(buf.is_inline());
+    std::string ans;
+    for (auto &i: buf) {
+        ans += i + " ";
+    }
+    ASSERT_TRUE(ans == "0 1 2 3 4 5 6 7 8 ");
+}
+
+TEST(SmallBufferTests, CopySwapTest) {
+    SmallDynamicBuffer<int, 4> small;
+    SmallDynamicBuffer<int, 4> large;
+    small.push_back(1);
+    for (int i = 0; i < 10; i++) {
+        large.push_back(i);
+    }
+    SmallDynamicBuffer<int, 4> copy(small);
+    ASSERT_TRUE(copy.is_inline() && copy.front() == 1);
+    small.swap(large);
+    ASSERT_TRUE(small.size() == 10 && small.back() == 9 && large.size() == 1 && large.front() == 1);
+    large.push_back(2);
+    ASSERT_TRUE(large.size() == 2 && large.back() == 2);
+}
+
+TEST(SmallBufferTests, GrowInlineTest) {
+    SmallDynamicBuffer<int, 8> buf(2);
+    buf.push_back(0);
+    buf.push_back(1);
+    buf.pop_front();
+    for (int i = 2; i < 9; i++) {
+        buf.push_back(i);
+    }
+    ASSERT_TRUE(buf.is_inline() && buf.size() == 8 && buf.front() == 1 && buf.back() == 8);
+    buf.push_back(9);
+    ASSERT_FALSE(buf.is_inline());
+    ASSERT_TRUE(buf.size() == 9 && buf.front() == 1 && buf.back() == 9);
+    SmallDynamicBuffer<int, 8> reserved(2);
+    reserved.reserve(5);
+    ASSERT_TRUE(reserved.is_inline() && reserved.capacity() == 5);
+}
+
+TEST(SmallBufferTests, InlineSwapTest) {
+    static_assert(noexcept(std::declval<SmallDynamicBuffer<int, 4> &>().swap(
+            std::declval<SmallDynamicBuffer<int, 4> &>())));
+    SmallDynamicBuffer<std::string, 4> a;
+    SmallDynamicBuffer<std::string, 4> b;
+    for (int i = 0; i < 4; i++) {
+        a.push_back(std::to_string(i));
+    }
+    a.pop_front();
+    a.push_back("4");
+    b.push_back("x");
+    a.swap(b);
+    ASSERT_TRUE(a.is_inline() && b.is_inline());
+    ASSERT_TRUE(a.size() == 1 && a.front() == "x");
+    ASSERT_TRUE(b.size() == 4 && b.front() == "1" && b.back() == "4");
+    SmallDynamicBuffer<std::string, 4> heap;
+    for (int i = 0; i < 6; i++) {
+        heap.push_back(std::to_string(i));
+    }
+    const std::string *storage = &heap.front();
+    heap.swap(b);
+    ASSERT_TRUE(heap.is_inline() && heap.size() == 4 && heap.front() == "1");
+    ASSERT_TRUE(!b.is_inline() && &b.front() == storage && b.size() == 6 && b.back() == "5");
+    heap.swap(b);
+    ASSERT_TRUE(heap.size() == 6 && b.is_inline() && b.back() == "4");
+}
+
+TEST(CompactBufferTests, LayoutTest) {
+    static_assert(sizeof(CompactBuffer<int>) <= 24);
+    ASSERT_TRUE(sizeof(CompactBuffer<int>) < sizeof(DynamicBuffer<int>));
+    CompactBuffer<int> buf(4);
+    const int *storage = &buf.front();
+    for (int i = 0; i < 4; i++) {
+        buf.push_back(i);
+    }
+    buf.pop_front();
+    buf.push_back(4);
+    ASSERT_TRUE(buf.size() == 4 && buf.capacity() == 4 && &buf[3] == storage);
+    ASSERT_TRUE(buf.first_segment().size() == 3 && buf.second_segment().size() == 1);
+}
 
+TEST(CompactBufferTests, InsertAssignTest) {
+    CompactBuffer<int> buf;
+    buf.assign(3, 7);
+    ASSERT_TRUE(buf.size() == 3 && buf[0] == 7 && buf[2] == 7);
+    buf.assign({1, 5});
+    auto it = buf.insert(buf.begin() + 1, 2, 3);
+    ASSERT_TRUE(*it == 3 && it - buf.begin() == 1);
+    it = buf.insert(buf.begin() + 3, {4, 4});
+    ASSERT_TRUE(it - buf.begin() == 3);
+    std::vector<int> tail = {6, 8};
+    buf.insert(buf.end(), tail.begin(), tail.end());
+    std::vector<int> ans(buf.begin(), buf.end());
+    ASSERT_TRUE(ans == std::vector<int>({1, 3, 3, 4, 4, 5, 6, 8}));
+}
+
+TEST(CompactBufferTests, AliasedInsertTest) {
+    CompactBuffer<std::string> buf;
+    buf.push_back(std::string(40, 'a'));
+    buf.insert(buf.begin(), 3, buf[0]);
+    ASSERT_TRUE(buf.size() == 4 && buf[0] == std::string(40, 'a') && buf[3] == buf[0]);
+}
+
+TEST(CompactBufferTests, CopyCleanupTest) {
+    {
+        CompactBuffer<ThrowingCopy, CountingAllocator<ThrowingCopy>> buf;
+        for (int i = 0; i < 5; i++) {
+            buf.push_back(ThrowingCopy(i));
+        }
+        int before = live_allocations;
+        ThrowingCopy::copies_left = 3;
+        ASSERT_THROW(auto copy(buf), std::runtime_error);
+        ThrowingCopy::copies_left = -1;
+        ASSERT_TRUE(live_allocations == before);
+    }
+    ASSERT_TRUE(live_allocations == 0);
+}
+
+TEST(CompactBufferTests, DequeModelTest) {
+    CompactBuffer<std::string> buf;
+    std::deque<std::string> model;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 3000; i++) {
+        std::string value = std::to_string(i);
+        switch (gen() % 4) {
+            case 0:
+                buf.push_back(value);
+                model.push_back(value);
+                break;
+            case 1:
+                buf.push_front(value);
+                model.push_front(value);
+                break;
+            case 2:
+                buf.pop_back();
+                if (!model.empty()) model.pop_back();
+                break;
+            default:
+                buf.pop_front();
+                if (!model.empty()) model.pop_front();
+        }
+    }
+    ASSERT_TRUE(std::equal(buf.begin(), buf.end(), model.begin(), model.end()));
+    CompactBuffer<std::string> copy(buf);
+    ASSERT_TRUE(copy == buf);
+}
+
+TEST(CompactBufferTests, InsertEraseTest) {
+    CompactBuffer<int> buf;
+    buf.assign({0, 1, 2, 3, 4});
+    buf.insert(buf.begin() + 2, 10);
+    buf.erase(buf.begin(), buf.begin() + 2);
+    std::sort(buf.begin(), buf.end());
+    std::string ans;
+    for (auto i: buf) {
+        ans += std::to_string(i) + " ";
+    }
+    ASSERT_TRUE(ans == "2 3 4 10 ");
+}
+
+TEST(WorkStealingDequeTests, OrderTest) {
+    WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 10; i++) {
+        deque.push(i);
+    }
+    ASSERT_TRUE(deque.size() == 10 && deque.capacity() >= 10);
+    ASSERT_TRUE(deque.pop() == 9 && deque.steal() == 0 && deque.steal() == 1 && deque.pop() == 8);
+    while (deque.pop()) {}
+    ASSERT_TRUE(deque.empty() && !deque.steal());
+}
+
+TEST(WorkStealingDequeTests, ConcurrentStealTest) {
+    WorkStealingDeque<int> deque(4);
+    const int count = 100000;
+    std::atomic<bool> done{false};
+    std::vector<std::vector<int>> stolen(3);
+    std::vector<std::thread> thieves;
+    for (auto &out: stolen) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !deque.empty()) {
+                if (auto x = deque.steal()) out.push_back(*x);
+            }
+        });
+    }
+    std::vector<int> popped;
+    for (int i = 0; i < count; i++) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (auto x = deque.pop()) popped.push_back(*x);
+        }
+    }
+    done = true;
+    for (auto &t: thieves) {
+        t.join();
+    }
+    for (auto &out: stolen) {
+        popped.insert(popped.end(), out.begin(), out.end());
+    }
+    std::sort(popped.begin(), popped.end());
+    ASSERT_TRUE(popped.size() == count && std::adjacent_find(popped.begin(), popped.end()) == popped.end());
+}
+
+TEST(CompareTests, EqualityAcrossWrapTest) {
+    StaticBuffer<int> a(5);
+    StaticBuffer<int> b(7);
+    for (int i = 0; i < 5; i++) {
+        a.push_back(i);
+        b.push_back(i);
+    }
+    a.pop_front();
+    a.pop_front();
+    a.push_back(5);
+    a.push_back(6);
+    b.pop_front();
+    b.pop_front();
+    b.push_back(5);
+    b.push_back(6);
+    ASSERT_FALSE(a.second_segment().empty());
+    ASSERT_TRUE(a == b && !(a != b));
+    ASSERT_TRUE(std::hash<StaticBuffer<int>>()(a) == std::hash<StaticBuffer<int>>()(b));
+    b.pop_back();
+    ASSERT_TRUE(a != b && b < a && a > b);
+    b.push_back(7);
+    ASSERT_TRUE(a < b && (a <=> b) == std::strong_ordering::less);
+}
+
+TEST(CompareTests, HashStringTest) {
+    DynamicBuffer<std::string> a;
+    DynamicBuffer<std::string> b;
+    for (int i = 0; i < 6; i++) {
+        a.push_back(std::to_string(i));
+        b.push_front(std::to_string(5 - i));
+    }
+    ASSERT_TRUE(a == b && a.hash() == b.hash());
+    b.back() = "x";
+    ASSERT_TRUE(a != b && a.hash() != b.hash() && a < b);
+}
+
+TEST(CompareTests, FindSearchTest) {
+    StaticBuffer<char> buf(8);
+    for (char c: std::string("xxabcd")) {
+        buf.push_back(c);
+    }
+    buf.pop_front();
+    buf.pop_front();
+    for (char c: std::string("efgh")) {
+        buf.push_back(c);
+    }
+    ASSERT_FALSE(buf.second_segment().empty());
+    ASSERT_TRUE(buf.contains('g') && !buf.contains('x'));
+    ASSERT_TRUE(buf.find('f') - buf.begin() == 5 && buf.find('z') == buf.end());
+    std::string needle = "cdef";
+    ASSERT_TRUE(buf.search(needle.begin(), needle.end()) - buf.begin() == 2);
+    needle = "gh";
+    ASSERT_TRUE(buf.search(needle.begin(), needle.end()) - buf.begin() == 6);
+    needle = "hg";
+    ASSERT_TRUE(buf.search(needle.begin(), needle.end()) == buf.end());
+}
+
+constexpr int constexprDynamicSum() {
+    DynamicBuffer<int> buf;
+    for (int i = 1; i <= 10; i++) {
+        buf.push_back(i);
+    }
+    buf.pop_front();
+    buf.push_front(100);
+    buf.reserve(32);
+    int sum = 0;
+    for (auto it = buf.begin(); it != buf.end(); ++it) {
+        sum += *it;
+    }
+    return sum + buf[1] + buf.back();
+}
+
+constexpr bool constexprStaticWrap() {
+    StaticBuffer<int> buf(4);
+    for (int i = 0; i < 10; i++) {
+        if (buf.size() == buf.capacity()) buf.pop_front();
+        buf.push_back(i);
+    }
+    StaticBuffer<int> copy(buf);
+    return buf.front() == 6 && buf.back() == 9 && buf.end() - buf.begin() == 4 && copy == buf;
+}
+
+TEST(ConstexprTests, CycleBufferTest) {
+    static_assert(constexprDynamicSum() == 54 + 100 + 2 + 10);
+    static_assert(constexprStaticWrap());
+    ASSERT_TRUE(constexprDynamicSum() == 166);
+    ASSERT_TRUE(constexprStaticWrap());
+}
+
+constexpr FixedBuffer<int, 4> makeWindow() {
+    FixedBuffer<int, 4> buf;
+    for (int i = 0; i < 6; i++) {
+        if (buf.full()) buf.pop_front();
+        buf.push_back(i * i);
+    }
+    return buf;
+}
+
+TEST(ConstexprTests, FixedBufferTest) {
+    constexpr auto window = makeWindow();
+    static_assert(window.size() == 4 && window.front() == 4 && window.back() == 25);
+    static_assert(window == FixedBuffer<int, 4>{4, 9, 16, 25});
+    int sum = 0;
+    for (int x: window) {
+        sum += x;
+    }
+    ASSERT_TRUE(sum == 54);
+    FixedBuffer<int, 2> buf{1, 2};
+    ASSERT_THROW(buf.push_front(0), std::out_of_range);
+    buf.pop_back();
+    buf.push_front(0);
+    ASSERT_TRUE(buf[0] == 0 && buf.at(1) == 1);
+}
+
+TEST(IndexIteratorTests, SharedIteratorTest) {
+    static_assert(std::random_access_iterator<CompactBuffer<int>::iterator>);
+    static_assert(std::random_access_iterator<SegmentedBuffer<int>::const_iterator>);
+    static_assert(std::random_access_iterator<FixedBuffer<int, 4>::iterator>);
+    CompactBuffer<std::string> buf;
+    buf.push_back("b");
+    buf.push_front("a");
+    auto it = buf.begin();
+    ASSERT_TRUE(it->size() == 1 && it[1] == "b" && (1 + it) - buf.begin() == 1);
+    CompactBuffer<std::string>::const_iterator cit = buf.cbegin();
+    ASSERT_TRUE(*cit == "a" && cit + 2 == buf.cend());
+}
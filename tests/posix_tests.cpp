@@ -0,0 +1,167 @@
+// Tests for the descriptor- and shared-memory-based containers; built only on UNIX.
+#include "./lib/ByteBuffer/ByteBuffer.hpp"
+#ifdef __linux__
+#include "./lib/SharedRing/SharedRing.hpp"
+#endif
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+TEST(ByteBufferTests, PeekConsumeTest) {
+    ByteBuffer<> buf(8);
+    buf.append("abcdef", 6);
+    buf.consume(4);
+    buf.append("ghijk", 5);
+    ASSERT_TRUE(buf.size() == 7 && buf.capacity() == 8);
+    char out[16];
+    ASSERT_TRUE(buf.peek(out, sizeof(out)) == 7 && std::string(out, 7) == "efghijk");
+    ASSERT_TRUE(buf.peek().size() < 7);
+    buf.append("lmnop", 5);
+    ASSERT_TRUE(buf.size() == 12 && std::string(buf.peek().data(), 12) == "efghijklmnop");
+}
+
+TEST(ByteBufferTests, DescriptorTest) {
+    int in[2];
+    int out[2];
+    ASSERT_TRUE(pipe(in) == 0 && pipe(out) == 0);
+    ByteBuffer<> buf(16);
+    std::string sent;
+    std::string received;
+    for (int round = 0; round < 20; round++) {
+        std::string chunk(5 + round % 7, static_cast<char>('a' + round));
+        sent += chunk;
+        ASSERT_TRUE(write(in[1], chunk.data(), chunk.size()) == static_cast<ssize_t>(chunk.size()));
+        ASSERT_TRUE(buf.read_from(in[0], 64) == static_cast<ssize_t>(chunk.size()));
+        ASSERT_TRUE(buf.write_to(out[1]) == static_cast<ssize_t>(chunk.size()) && buf.empty());
+        char tmp[64];
+        ssize_t n = read(out[0], tmp, sizeof(tmp));
+        received.append(tmp, n);
+    }
+    ASSERT_TRUE(received == sent);
+    for (int fd: {in[0], in[1], out[0], out[1]}) {
+        close(fd);
+    }
+}
+
+TEST(ByteBufferTests, WrappedReadTest) {
+    int p[2];
+    ASSERT_TRUE(pipe(p) == 0);
+    ByteBuffer<> buf(8);
+    buf.append("123456", 6);
+    buf.consume(5);
+    ASSERT_TRUE(write(p[1], "abcdef", 6) == 6);
+    ASSERT_TRUE(buf.read_from(p[0], 6) == 6);
+    ASSERT_FALSE(buf.second_segment().empty());
+    char out[8];
+    ASSERT_TRUE(buf.peek(out, 8) == 7 && std::string(out, 7) == "6abcdef");
+    close(p[0]);
+    close(p[1]);
+}
+
+TEST(ByteBufferTests, ReadGrowthTest) {
+    int p[2];
+    ASSERT_TRUE(pipe(p) == 0);
+    ByteBuffer<> buf(16);
+    buf.append("1234", 4);
+    ASSERT_TRUE(write(p[1], "abcdefgh", 8) == 8);
+    ASSERT_TRUE(buf.read_from(p[0], 8) == 8 && buf.capacity() == 16);
+    ASSERT_TRUE(write(p[1], "ijklmnop", 8) == 8);
+    ASSERT_TRUE(buf.read_from(p[0], 8) == 8 && buf.capacity() == 32);
+    size_t reallocations = 0;
+    for (int i = 0; i < 256; i++) {
+        size_t capacity = buf.capacity();
+        ASSERT_TRUE(write(p[1], "abcdefgh", 8) == 8);
+        ASSERT_TRUE(buf.read_from(p[0], 8) == 8);
+        if (buf.capacity() != capacity) reallocations++;
+    }
+    ASSERT_TRUE(buf.size() == 20 + 256 * 8 && reallocations <= 7);
+    ASSERT_THROW(buf.read_from(p[0], 0), std::out_of_range);
+    close(p[1]);
+    ASSERT_TRUE(buf.read_from(p[0], 4) == 0);
+    close(p[0]);
+}
+
+#ifdef __linux__
+
+TEST(SharedRingTests, ForkTest) {
+    auto ring = SharedRing<uint64_t>::create("", 8);
+    pid_t pid = fork();
+    ASSERT_TRUE(pid >= 0);
+    if (pid == 0) {
+        for (uint64_t i = 0; i < 10000; i++) {
+            while (!ring.try_push(i * 3)) {}
+        }
+        _exit(0);
+    }
+    bool ordered = true;
+    for (uint64_t i = 0; i < 10000; i++) {
+        if (ring.pop() != i * 3) ordered = false;
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(ordered && ring.empty() && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+TEST(SharedRingTests, NamedOpenTest) {
+    std::string name = "/cycle_ring_test_" + std::to_string(getpid());
+    auto ring = SharedRing<int>::create(name, 4);
+    ASSERT_THROW(SharedRing<int>::create(name, 4), std::system_error);
+    ASSERT_THROW(SharedRing<double>::open(name), std::runtime_error);
+    auto other = SharedRing<int>::open(name);
+    SharedRingBase::unlink(name);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(ring.try_push(i));
+    }
+    ASSERT_FALSE(ring.try_push(4));
+    int value = -1;
+    ASSERT_TRUE(other.try_pop(value) && value == 0 && other.size() == 3);
+}
+
+TEST(SharedRingTests, RecordForkTest) {
+    auto ring = SharedRecordRing::create("", 256);
+    pid_t pid = fork();
+    ASSERT_TRUE(pid >= 0);
+    if (pid == 0) {
+        for (int i = 0; i < 2000; i++) {
+            std::string record(i % 50, static_cast<char>('a' + i % 26));
+            while (!ring.try_push(record.data(), record.size())) {}
+        }
+        _exit(0);
+    }
+    bool intact = true;
+    for (int i = 0; i < 2000; i++) {
+        std::vector<char> record = ring.pop();
+        if (record != std::vector<char>(i % 50, static_cast<char>('a' + i % 26))) intact = false;
+    }
+    waitpid(pid, nullptr, 0);
+    ASSERT_TRUE(intact);
+    ASSERT_THROW(ring.try_push("x", ring.max_record_size() + 1), std::out_of_range);
+}
+
+TEST(SharedRingTests, CorruptRecordTest) {
+    std::string name = "/cycle_record_test_" + std::to_string(getpid());
+    auto ring = SharedRecordRing::create(name, 64);
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    SharedRingBase::unlink(name);
+    ASSERT_TRUE(fd >= 0);
+    struct stat st{};
+    fstat(fd, &st);
+    auto *bytes = static_cast<unsigned char *>(mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    ASSERT_TRUE(ring.try_push("abc", 3));
+    unsigned char *prefix = bytes + st.st_size - 64;
+    uint64_t length = 0;
+    std::memcpy(&length, prefix, 8);
+    ASSERT_TRUE(length == 3);
+    length = 1 << 20;
+    std::memcpy(prefix, &length, 8);
+    std::vector<char> record;
+    ASSERT_THROW(ring.try_pop(record), std::runtime_error);
+    length = 3;
+    std::memcpy(prefix, &length, 8);
+    ASSERT_TRUE(ring.try_pop(record) && record == std::vector<char>({'a', 'b', 'c'}));
+    munmap(bytes, st.st_size);
+}
+
+#endif